@@ -5,20 +5,26 @@
 //
 // Example sketch: Power Outage Logger using Microchip MCP79412 RTC.
 // Assumes the RTC is running and set to UTC.
-// A maximum of 7 outages (power down/up times) can be logged in the
-// RTC's SRAM.
-// The logging data structure is automatically initialized if not
-// present. An initialization can be forced with a button switch
-// connected from pin 9 to ground. Hold the button down
-// while resetting the MCU to initialize the logging data.
+// Outages (power down/up times) are recorded in the RTC's SRAM with the
+// MCP79412OutageJournal class, which keeps the six most recent outages
+// along with running statistics for all of them, so the statistics
+// are available at startup without reading every entry. When the
+// SRAM is full, the oldest outages are moved to the RTC's EEPROM.
+// The journal is automatically initialized if not present. An
+// initialization can be forced with a button switch connected from
+// pin 9 to ground. Hold the button down while resetting the MCU to
+// initialize the journal.
 //
 // Jack Christensen 23Aug2012
 
 #include <MCP79412RTC.h>    // https://github.com/JChristensen/MCP79412RTC
+#include <MCP79412OutageJournal.h>
 #include <Streaming.h>      // https://github.com/janelia-arduino/Streaming
 #include <Timezone.h>       // https://github.com/JChristensen/Timezone
 
 MCP79412RTC myRTC;
+MCP79412OutageJournal journal(myRTC);
+MCP79412EepromLog eepromLog(myRTC, sizeof(MCP79412OutageJournal::SPILL_t));
 
 void setup()
 {
@@ -33,9 +39,14 @@ void setup()
     if (timeStatus()!= timeSet) Serial << " FAIL";
     Serial << endl;
 
-    if (!digitalRead(initButton)) logClear();
-    logOutage();
-    //myRTC.dumpSRAM();
+    eepromLog.begin();
+    if (!digitalRead(initButton)) {
+        journal.clear();
+        eepromLog.clear();
+        Serial << "Logging initialized" << endl;
+    }
+    if (journal.begin(&eepromLog)) Serial << "New power outage logged" << endl;
+    printOutages();
 }
 
 // US Eastern Time Zone (New York, Detroit)
@@ -59,113 +70,36 @@ void loop()
     }
 }
 
-// constants for logging
-constexpr uint8_t
-    firstOutageAddr {0x08},     // address of first outage timestamps in RTC SRAM
-    outageLength    {8},        // 8 data bytes for each outage (start and end timestamps, both are time_t values)
-    maxOutages      {7},        // maximum number of outage timestamp pairs that can be stored in SRAM
-    lastOutageAddr  {firstOutageAddr + outageLength * (maxOutages - 1)},    // last outage address
-    appID           {1},        // appID and 4 bytes of the RTC ID are stored in sram to provide
-                                // a way to recognize that the logging data structure has been initialized
-    rtcID           {0x00},     // lower 4 bytes of RTC unique ID are stored at sram addr 0x00
-    appAddr         {0x04},     // address of appID in sram
-    nbrOutagesAddr  {0x05},     // address containing number of outages currently stored in SRAM
-    nextOutageAddr  {0x06},     // address containing pointer to next outage
-    rfuAddr         {0x07};     // reserved for future use
-
-// initialize the log data structure in the RTC SRAM if needed.
-// log a new outage if one occurred.
-// print out the outages logged.
-void logOutage() {
-    union {
-        uint8_t b[8];
-        struct {
-            uint32_t hi;
-            uint32_t lo;
-        };
-    } uniqueID;                 // 8-byte RTC "unique ID" with access to upper and lower halves
-
-    myRTC.idRead(uniqueID.b);           // get the RTC's ID
-    uint32_t loID = read32(rtcID);      // if already initialized, the lower half of the ID is stored in SRAM,
-    uint8_t app = myRTC.sramRead(appAddr);  // and also the app ID
-    Serial << "RTC ID";
-    for (uint8_t i=0; i<8; i++) {
-        Serial << (uniqueID.b[i] < 16 ? " 0" : " ") << _HEX(uniqueID.b[i]);
-    }
-    Serial << endl;
-
-    if ( loID != uniqueID.lo || app != appID ) {            // logging initialized?
-        write32(rtcID, uniqueID.lo);                        // least significant half of the RTC unique ID
-        myRTC.sramWrite(appAddr, appID);                    // app ID
-        myRTC.sramWrite(nbrOutagesAddr, 0);                 // number of outages
-        myRTC.sramWrite(nextOutageAddr, firstOutageAddr);   // next location for outage times
-        myRTC.sramWrite(rfuAddr, 0);                        // reserved for future use
-        Serial << "Logging initialized" << endl;            // no, do it now
-    }
-
-    // if an outage has occurred, record it
-    time_t powerDown, powerUp;  // power outage timestamps
-    uint8_t nOutage;            // number of outages stored in sram
-    uint8_t nextOutage;         // address of next outage timestamps in sram
-    if ( myRTC.powerFail(&powerDown, &powerUp) ) {
-        nOutage = myRTC.sramRead(nbrOutagesAddr);
-        nextOutage = myRTC.sramRead(nextOutageAddr);
-        write32(nextOutage, powerDown);
-        write32(nextOutage + 4, powerUp);
-        nextOutage += outageLength;
-        if (nextOutage > lastOutageAddr) nextOutage = firstOutageAddr;
-        myRTC.sramWrite(nextOutageAddr, nextOutage);
-        if (nOutage < maxOutages) myRTC.sramWrite(nbrOutagesAddr, ++nOutage);
-    }
-
-    // print out all the outages logged
-    nOutage = myRTC.sramRead(nbrOutagesAddr);
-    nextOutage = myRTC.sramRead(nextOutageAddr);
-    uint8_t outageAddr = nextOutage - outageLength;
-    if (outageAddr < firstOutageAddr) outageAddr = lastOutageAddr;
-    Serial << endl << "Power outages logged: " << _DEC(nOutage) << endl;
-    for (uint8_t i=nOutage; i>0; i--) {
-        powerDown = read32(outageAddr);
-        powerUp = read32(outageAddr + 4);
-        Serial << endl << _DEC(i) << ": Power down ";
-        printTime(myTZ.toLocal(powerDown, &tcr), tcr -> abbrev);
-        Serial << _DEC(i) << ": Power up   ";
-        printTime(myTZ.toLocal(powerUp, &tcr), tcr -> abbrev);
-        outageAddr -= outageLength;
-        if (outageAddr < firstOutageAddr) outageAddr = lastOutageAddr;
-    }
-}
-
-// initialize the logging data structure and log data
-void logClear()
+// print the outage statistics and the outages logged
+void printOutages()
 {
-    for (uint8_t i=0; i<lastOutageAddr + outageLength; i++) {
-        myRTC.sramWrite(i, 0);
+    Serial << endl << "Power outages: " << journal.count()
+        << ", total " << journal.totalDowntime() / 60 << " min"
+        << ", longest " << journal.maxDowntime() / 60 << " min"
+        << ", average " << journal.meanDowntime() / 60 << " min" << endl;
+
+    time_t powerDown, powerUp;
+    for (uint8_t i=0; journal.recent(i, powerDown, powerUp); i++) {
+        time_t local = myTZ.toLocal(powerDown, &tcr);   // sets tcr
+        Serial << endl << _DEC(i+1) << ": Power down ";
+        printTime(local, tcr -> abbrev);
+        local = myTZ.toLocal(powerUp, &tcr);
+        Serial << _DEC(i+1) << ": Power up   ";
+        printTime(local, tcr -> abbrev);
     }
-}
-
-// write a time_t or other uint32_t value to sram starting at addr
-void write32(uint8_t addr, uint32_t t)
-{
-    union {
-        uint8_t b[4];
-        uint32_t t;
-    } i;
 
-    i.t = t;
-    myRTC.sramWrite(addr, i.b, 4);
-}
-
-// read a time_t or other uint32_t value from sram starting at addr
-time_t read32(uint8_t addr)
-{
-    union {
-        uint8_t b[4];
-        time_t t;
-    } i;
-
-    myRTC.sramRead(addr, i.b, 4);
-    return i.t;
+    MCP79412OutageJournal::SPILL_t old;
+    if (eepromLog.count()) Serial << endl << "Older outages (from EEPROM):" << endl;
+    for (uint8_t i=0; eepromLog.read(i, &old); i++) {
+        Serial << "Power down ";
+        time_t local = myTZ.toLocal(old.powerDown, &tcr);
+        sPrintI00(hour(local));
+        sPrintDigits(minute(local));
+        Serial << ' ';
+        sPrintI00(day(local));
+        Serial << ' ' << monthShortStr(month(local)) << ' ' << year(local) << ' ' << tcr -> abbrev
+            << ", " << old.minutes << " min" << endl;
+    }
 }
 
 // Print time with time zone
@@ -0,0 +1,65 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Example sketch: Interrupt-driven alarms. Connect the RTC's MFP pin to
+// an interrupt pin. Alarm 0 fires at 5 seconds after every minute and
+// alarm 1 at 35 seconds. With the alarm polarity HIGH, the MFP goes
+// active when either alarm fires. An MCP79412AlarmService notes the
+// interrupt, and loop() reads and clears the alarm flags only then,
+// instead of polling the RTC with alarm().
+//
+// Jack Christensen 2025
+
+#include <MCP79412RTC.h>            // https://github.com/JChristensen/MCP79412RTC
+#include <MCP79412AlarmService.h>
+#include <TimeLib.h>                // https://github.com/PaulStoffregen/Time
+
+constexpr uint8_t MFP_PIN {3};      // the RTC's MFP, can use pin 2 or 3 on an Uno
+
+MCP79412RTC myRTC;
+MCP79412AlarmService alarms(myRTC);
+
+void setup()
+{
+    Serial.begin(115200);
+    Serial.println(F("\n" __FILE__ " " __DATE__ " " __TIME__));
+    myRTC.begin();
+    myRTC.squareWave(MCP79412RTC::SQWAVE_NONE);
+    myRTC.alarmPolarity(HIGH);      // MFP active when either alarm fires
+    myRTC.setAlarm(MCP79412RTC::ALARM_0, 2025, 1, 1, 0, 0, 5);
+    myRTC.enableAlarm(MCP79412RTC::ALARM_0, MCP79412RTC::ALM_MATCH_SECONDS);
+    myRTC.setAlarm(MCP79412RTC::ALARM_1, 2025, 1, 1, 0, 0, 35);
+    myRTC.enableAlarm(MCP79412RTC::ALARM_1, MCP79412RTC::ALM_MATCH_SECONDS);
+    alarms.begin(MFP_PIN);          // after setting the polarity
+}
+
+void loop()
+{
+    uint8_t fired = alarms.service();   // no I2C traffic unless an alarm is pending
+    if (fired & MCP79412AlarmService::ALARM0) printAlarm(0);
+    if (fired & MCP79412AlarmService::ALARM1) printAlarm(1);
+}
+
+// print the alarm number and the time
+void printAlarm(uint8_t n)
+{
+    time_t t = myRTC.get();
+    Serial.print(F("ALARM_"));
+    Serial.print(n);
+    printI00(hour(t), ' ');
+    printI00(minute(t), ':');
+    printI00(second(t), ':');
+    Serial.println();
+}
+
+// Print an integer in "00" format (with leading zero),
+// preceded by a delimiter.
+// Input value assumed to be between 0 and 99.
+void printI00(int val, char delim)
+{
+    Serial.print(delim);
+    if (val < 10) Serial.print('0');
+    Serial.print(val);
+}
@@ -0,0 +1,73 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Example sketch: Keep time with millis(), reading the RTC only
+// occasionally. An MCP79412CachedClock object is the Time library's
+// sync provider. It learns how fast millis() runs relative to the RTC,
+// and resynchronizes less and less often as its estimate improves.
+// The time is printed every second; once a minute, the measured drift,
+// the resync interval and the number of RTC reads so far are printed.
+//
+// Jack Christensen 2025
+
+#include <MCP79412RTC.h>            // https://github.com/JChristensen/MCP79412RTC
+#include <MCP79412CachedClock.h>
+#include <TimeLib.h>                // https://github.com/PaulStoffregen/Time
+
+MCP79412RTC myRTC;
+MCP79412CachedClock myClock(myRTC, 20);     // keep the error within 20ms
+
+void setup()
+{
+    Serial.begin(115200);
+    Serial.println(F("\n" __FILE__ " " __DATE__ " " __TIME__));
+    myRTC.begin();
+    if (!myClock.begin()) Serial.println(F("RTC is not running!"));
+    setSyncProvider([](){return myClock.get();});
+    setSyncInterval(1);
+}
+
+void loop()
+{
+    static time_t tLast;
+
+    myClock.poll();
+    time_t t = now();
+    if (t != tLast) {
+        tLast = t;
+        printDateTime(t);
+        if (second(t) == 0) {
+            Serial.print(F("Drift "));
+            Serial.print(myClock.drift() / 1000);
+            Serial.print(F(" ppm, resync every "));
+            Serial.print(myClock.syncInterval());
+            Serial.print(F(" s, "));
+            Serial.print(myClock.readCount());
+            Serial.println(F(" RTC reads"));
+        }
+    }
+}
+
+// print date and time to Serial
+void printDateTime(time_t t)
+{
+    Serial.print(year(t));
+    printI00(month(t), '-');
+    printI00(day(t), '-');
+    printI00(hour(t), ' ');
+    printI00(minute(t), ':');
+    printI00(second(t), ':');
+    Serial.println();
+}
+
+// Print an integer in "00" format (with leading zero),
+// preceded by a delimiter.
+// Input value assumed to be between 0 and 99.
+void printI00(int val, char delim)
+{
+    Serial.print(delim);
+    if (val < 10) Serial.print('0');
+    Serial.print(val);
+}
@@ -0,0 +1,70 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Example sketch: Calibrate the RTC from reference times sent over
+// the serial port. Send "T" followed by the Unix time, e.g. from a
+// host synchronized with NTP:
+//     date +T%s > /dev/ttyACM0
+// ideally just after the start of a second, and from time to time
+// over a few days. Each reference time is paired with the RTC's time.
+// When the samples span at least a day, the calibration is applied,
+// and the calibration history is printed.
+//
+// Jack Christensen 2025
+
+#include <MCP79412RTC.h>            // https://github.com/JChristensen/MCP79412RTC
+#include <MCP79412Calibrator.h>
+
+MCP79412RTC myRTC;
+MCP79412Calibrator calibrator(myRTC);
+
+void setup()
+{
+    Serial.begin(115200);
+    Serial.println(F("\n" __FILE__ " " __DATE__ " " __TIME__));
+    myRTC.begin();
+    printHistory();
+}
+
+void loop()
+{
+    if (Serial.available() && Serial.read() == 'T') {
+        time_t ref = Serial.parseInt();
+        while (Serial.available()) Serial.read();   // dump extraneous input
+        calibrator.addSample(ref);
+        Serial.print(F("Samples "));
+        Serial.print(calibrator.samples());
+        Serial.print(F(" over "));
+        Serial.print(calibrator.span() / 3600.0, 1);
+        Serial.print(F(" hours, drift "));
+        Serial.print(calibrator.drift());
+        Serial.println(F(" ppm"));
+
+        if (calibrator.span() >= 86400) {
+            bool coarse;
+            int trim = calibrator.optimalTrim(coarse);
+            calibrator.apply();
+            Serial.print(F("Calibration applied: "));
+            Serial.print(trim);
+            Serial.println(coarse ? F(" coarse") : F(" fine"));
+            printHistory();
+        }
+    }
+}
+
+// print the calibration history, newest first
+void printHistory()
+{
+    MCP79412Calibrator::CAL_RECORD_t rec;
+    Serial.println(F("Calibration history:"));
+    for (uint8_t i=0; calibrator.historyRead(i, rec); ++i) {
+        Serial.print(rec.time);
+        Serial.print(F(" drift "));
+        Serial.print(rec.drift / 10.0, 1);
+        Serial.print(F(" ppm, trim "));
+        Serial.print(rec.trim);
+        Serial.println((rec.flags & 0x80) ? F(" coarse") : F(" fine"));
+    }
+}
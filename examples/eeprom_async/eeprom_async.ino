@@ -0,0 +1,66 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Example sketch: Write to the RTC's EEPROM without blocking.
+// Once a minute, a 24-byte configuration block is saved to EEPROM.
+// The writes are queued with an MCP79412EepromWriter object and carried
+// out by calling its poll() function from loop(), so the loop keeps
+// running (here, counting iterations as a stand-in for sampling a
+// sensor) while the EEPROM works through its write cycles.
+//
+// Jack Christensen 2025
+
+#include <MCP79412RTC.h>            // https://github.com/JChristensen/MCP79412RTC
+#include <MCP79412EepromWriter.h>
+
+MCP79412RTC myRTC;
+MCP79412EepromWriter eeWriter(myRTC);
+
+struct config_t {
+    uint32_t saveCount;
+    uint8_t settings[20];
+} config;
+
+void setup()
+{
+    Serial.begin(115200);
+    Serial.println(F("\n" __FILE__ " " __DATE__ " " __TIME__));
+    myRTC.begin();
+    myRTC.eepromRead(0, reinterpret_cast<uint8_t*>(&config), sizeof(config));
+    if (config.saveCount == 0xFFFFFFFF) config.saveCount = 0;   // erased EEPROM
+    Serial.print(F("Configuration has been saved "));
+    Serial.print(config.saveCount);
+    Serial.println(F(" times"));
+}
+
+void loop()
+{
+    static uint32_t msLast = millis();
+    static uint32_t loopCount;
+    static bool saving;
+
+    ++loopCount;        // a stand-in for some real work
+
+    if (millis() - msLast >= 60000) {
+        msLast += 60000;
+        ++config.saveCount;
+        if ( eeWriter.write(0, reinterpret_cast<uint8_t*>(&config), sizeof(config)) ) {
+            saving = true;
+            loopCount = 0;
+        }
+        else {
+            Serial.println(F("EEPROM write queue full"));
+        }
+    }
+
+    if (eeWriter.poll() != MCP79412EepromWriter::EE_BUSY && saving) {
+        saving = false;
+        Serial.print(F("Save "));
+        Serial.print(config.saveCount);
+        Serial.print(eeWriter.status() == MCP79412EepromWriter::EE_IDLE ? F(" complete, ") : F(" FAILED, "));
+        Serial.print(loopCount);
+        Serial.println(F(" loop iterations while writing"));
+    }
+}
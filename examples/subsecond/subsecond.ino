@@ -0,0 +1,70 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Example sketch: Millisecond timestamps from the RTC's square wave.
+// Connect the RTC's MFP pin to an interrupt pin. An MCP79412SubSecond
+// object counts the square wave edges, so timestamps come from the RTC
+// without reading it over I2C. Each press of a button is timestamped
+// and printed.
+//
+// Jack Christensen 2025
+
+#include <MCP79412RTC.h>            // https://github.com/JChristensen/MCP79412RTC
+#include <MCP79412SubSecond.h>
+#include <TimeLib.h>                // https://github.com/PaulStoffregen/Time
+
+constexpr uint8_t
+    MFP_PIN {3},        // the RTC's MFP, can use pin 2 or 3 on an Uno
+    BUTTON_PIN {7};     // a button from this pin to ground
+
+MCP79412RTC myRTC;
+MCP79412SubSecond subSec(myRTC);
+
+void setup()
+{
+    Serial.begin(115200);
+    Serial.println(F("\n" __FILE__ " " __DATE__ " " __TIME__));
+    pinMode(BUTTON_PIN, INPUT_PULLUP);
+    myRTC.begin();
+    if (!subSec.begin(MFP_PIN)) Serial.println(F("RTC is not running or MFP not connected!"));
+}
+
+void loop()
+{
+    static bool btnLast {HIGH};
+    bool btn = digitalRead(BUTTON_PIN);
+    if (btn != btnLast) {
+        btnLast = btn;
+        if (btn == LOW) printTimestamp(subSec.nowMillis());
+        delay(20);      // debounce
+    }
+}
+
+// print a millisecond timestamp as date, time and milliseconds
+void printTimestamp(uint64_t ms)
+{
+    time_t t = ms / 1000;
+    uint16_t msec = ms % 1000;
+    Serial.print(year(t));
+    printI00(month(t), '-');
+    printI00(day(t), '-');
+    printI00(hour(t), ' ');
+    printI00(minute(t), ':');
+    printI00(second(t), ':');
+    Serial.print('.');
+    if (msec < 100) Serial.print('0');
+    if (msec < 10) Serial.print('0');
+    Serial.println(msec);
+}
+
+// Print an integer in "00" format (with leading zero),
+// preceded by a delimiter.
+// Input value assumed to be between 0 and 99.
+void printI00(int val, char delim)
+{
+    Serial.print(delim);
+    if (val < 10) Serial.print('0');
+    Serial.print(val);
+}
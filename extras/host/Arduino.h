@@ -0,0 +1,116 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Minimal host (Linux) stand-in for the Arduino core, just enough to
+// compile and run the library against the MCP7941x simulator.
+// Time is virtual: millis() and micros() return a simulated clock that
+// advances only with bus traffic, delay() and hostAdvance(). Built with
+// HOST_REAL_TIME defined, e.g. for LinuxI2CTransport on a real
+// /dev/i2c-N, they return the real (monotonic) time and delay() sleeps.
+// This file is not part of the Arduino library build.
+
+#ifndef HOST_ARDUINO_H_INCLUDED
+#define HOST_ARDUINO_H_INCLUDED
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW  0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+#ifndef _BV
+#define _BV(bit) (1 << (bit))
+#endif
+
+// virtual time, in microseconds since "power up" (real time since the
+// first call with HOST_REAL_TIME)
+uint64_t hostMicros();
+void hostAdvance(uint64_t us);
+
+inline unsigned long millis() {return static_cast<unsigned long>(hostMicros() / 1000);}
+inline unsigned long micros() {return static_cast<unsigned long>(hostMicros());}
+inline void delay(unsigned long ms) {hostAdvance(static_cast<uint64_t>(ms) * 1000);}
+inline void delayMicroseconds(unsigned int us) {hostAdvance(us);}
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+inline void pinMode(uint8_t, uint8_t) {}
+int digitalRead(uint8_t pin);     // the level last given to hostPinChange(), else HIGH
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalPinToInterrupt(uint8_t pin) {return pin;}
+void attachInterrupt(uint8_t interruptNum, void (*isr)(), int mode);
+void detachInterrupt(uint8_t interruptNum);
+void hostRaiseInterrupt(uint8_t interruptNum);
+void hostPinChange(uint8_t interruptNum, bool level);
+
+// A source of events at given virtual times, e.g. a simulated device's
+// output pin. hostAdvance() stops at each event and calls onEvent().
+class HostTimer
+{
+    public:
+        virtual ~HostTimer() {}
+        virtual uint64_t nextEvent() = 0;   // virtual micros, UINT64_MAX for none
+        virtual void onEvent() = 0;
+};
+void hostAddTimer(HostTimer* t);
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define PROGMEM
+#define pgm_read_byte(p) (*reinterpret_cast<const uint8_t*>(p))
+
+// Print writes to stdout via write(); derived classes may capture instead.
+class Print
+{
+    public:
+        virtual ~Print() {}
+        virtual size_t write(uint8_t c);
+        size_t write(const char* s);
+        size_t print(const __FlashStringHelper* s);
+        size_t print(const char* s);
+        size_t print(char c);
+        size_t print(unsigned char n, int base=DEC);
+        size_t print(int n, int base=DEC);
+        size_t print(unsigned int n, int base=DEC);
+        size_t print(long n, int base=DEC);
+        size_t print(unsigned long n, int base=DEC);
+        size_t print(long long n, int base=DEC);
+        size_t print(unsigned long long n, int base=DEC);
+        size_t print(double n, int digits=2);
+        size_t println();
+        template<typename T> size_t println(T v) {return print(v) + println();}
+        template<typename T> size_t println(T v, int b) {return print(v, b) + println();}
+
+    private:
+        size_t printNumber(unsigned long long n, int base);
+};
+
+class HostSerial : public Print
+{
+    public:
+        void begin(unsigned long) {}
+        operator bool() {return true;}
+        int available() {return 0;}     // there is no serial input
+        int read() {return -1;}
+        long parseInt() {return 0;}
+};
+extern HostSerial Serial;
+
+#endif
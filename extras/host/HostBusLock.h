@@ -0,0 +1,28 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Host bus lock for MCP79412RTC::setBusLock(), using a
+// std::recursive_mutex, so the library can be run from several
+// std::threads. The critical section is a separate std::mutex. This file is not part of the Arduino library build.
+
+#ifndef HOST_BUS_LOCK_H_INCLUDED
+#define HOST_BUS_LOCK_H_INCLUDED
+
+#include <MCP79412BusLock.h>
+#include <mutex>
+
+class HostBusLock : public MCP79412BusLock
+{
+    public:
+        void lock() {m_mutex.lock();}
+        void unlock() {m_mutex.unlock();}
+        void enterCritical() {m_critical.lock();}
+        void exitCritical() {m_critical.unlock();}
+
+    private:
+        std::recursive_mutex m_mutex;
+        std::mutex m_critical;
+};
+#endif
@@ -0,0 +1,457 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Implementation of the host stand-ins for the Arduino core, Wire and
+// Time libraries. This file is not part of the Arduino library build.
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <TimeLib.h>
+#include <stdio.h>
+#ifdef HOST_REAL_TIME
+#include <errno.h>
+#include <time.h>
+#endif
+
+// ---- virtual clock and interrupts ----
+
+#ifdef HOST_REAL_TIME
+// Real time, for a real i2c-dev device: microseconds of CLOCK_MONOTONIC
+// since the first call. Advancing it sleeps. There are no simulated
+// events, so timers are ignored.
+uint64_t hostMicros()
+{
+    static uint64_t start {0};
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t us = static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+    if (start == 0) start = us;
+    return us - start;
+}
+
+void hostAdvance(const uint64_t us)
+{
+    timespec ts {static_cast<time_t>(us / 1000000), static_cast<long>(us % 1000000 * 1000)};
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {}
+}
+
+void hostAddTimer(HostTimer*) {}
+#else
+static uint64_t virtualMicros;
+static HostTimer* timers[4];
+static uint8_t nTimers;
+
+uint64_t hostMicros()
+{
+    return virtualMicros;
+}
+
+// Advance virtual time, stopping at each timer event on the way.
+void hostAdvance(const uint64_t us)
+{
+    uint64_t target = virtualMicros + us;
+    while (true) {
+        HostTimer* next {nullptr};
+        uint64_t when = target;
+        for (uint8_t i=0; i<nTimers; ++i) {
+            uint64_t t = timers[i]->nextEvent();
+            if (t <= when) {
+                when = t;
+                next = timers[i];
+            }
+        }
+        if (!next) break;
+        if (when > virtualMicros) virtualMicros = when;
+        next->onEvent();
+    }
+    virtualMicros = target;
+}
+
+void hostAddTimer(HostTimer* t)
+{
+    if (nTimers < sizeof timers / sizeof timers[0]) timers[nTimers++] = t;
+}
+#endif
+
+static void (*isrTable[64])();
+static int isrMode[64];
+static uint64_t lowPins;        // pins (interrupts) last changed to LOW
+
+void attachInterrupt(const uint8_t interruptNum, void (*isr)(), int mode)
+{
+    if (interruptNum < 64) {
+        isrTable[interruptNum] = isr;
+        isrMode[interruptNum] = mode;
+    }
+}
+
+void detachInterrupt(const uint8_t interruptNum)
+{
+    if (interruptNum < 64) isrTable[interruptNum] = nullptr;
+}
+
+// Call the handler attached to the given interrupt, if any, as if the
+// pin had seen the configured edge.
+void hostRaiseInterrupt(const uint8_t interruptNum)
+{
+    if (interruptNum < 64 && isrTable[interruptNum]) isrTable[interruptNum]();
+}
+
+// A pin changed to the given level; call the handler if the change
+// matches the mode it was attached with.
+void hostPinChange(const uint8_t interruptNum, const bool level)
+{
+    if (interruptNum >= 64) return;
+    if (level) lowPins &= ~(1ULL << interruptNum);
+    else lowPins |= 1ULL << interruptNum;
+    int mode = isrMode[interruptNum];
+    if (mode == CHANGE || (mode == RISING && level) || (mode == FALLING && !level)) {
+        hostRaiseInterrupt(interruptNum);
+    }
+}
+
+int digitalRead(const uint8_t pin)
+{
+    return (pin < 64 && (lowPins & 1ULL << pin)) ? LOW : HIGH;
+}
+
+// ---- Print and Serial ----
+
+HostSerial Serial;
+
+size_t Print::write(const uint8_t c)
+{
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t Print::write(const char* s)
+{
+    size_t n {0};
+    while (*s) n += write(static_cast<uint8_t>(*s++));
+    return n;
+}
+
+size_t Print::print(const __FlashStringHelper* s) {return write(reinterpret_cast<const char*>(s));}
+size_t Print::print(const char* s) {return write(s);}
+size_t Print::print(const char c) {return write(static_cast<uint8_t>(c));}
+size_t Print::print(const unsigned char n, const int base) {return printNumber(n, base);}
+size_t Print::print(const unsigned int n, const int base) {return printNumber(n, base);}
+size_t Print::print(const unsigned long n, const int base) {return printNumber(n, base);}
+size_t Print::print(const unsigned long long n, const int base) {return printNumber(n, base);}
+size_t Print::print(const int n, const int base) {return print(static_cast<long long>(n), base);}
+size_t Print::print(const long n, const int base) {return print(static_cast<long long>(n), base);}
+
+size_t Print::print(const long long n, const int base)
+{
+    if (n < 0 && base == DEC) return write('-') + printNumber(-n, base);
+    return printNumber(static_cast<unsigned long long>(n), base);
+}
+
+size_t Print::print(const double n, const int digits)
+{
+    char buf[48];
+    snprintf(buf, sizeof buf, "%.*f", digits, n);
+    return write(buf);
+}
+
+size_t Print::println()
+{
+    return write("\r\n");
+}
+
+size_t Print::printNumber(unsigned long long n, const int base)
+{
+    char buf[8 * sizeof n + 1];
+    char* p {buf + sizeof buf - 1};
+    *p = '\0';
+    do {
+        uint8_t d = n % base;
+        *--p = d < 10 ? '0' + d : 'A' + d - 10;
+        n /= base;
+    } while (n);
+    return write(p);
+}
+
+// ---- TwoWire ----
+
+TwoWire Wire;
+
+TwoWire::TwoWire()
+    : nDevs{0}, active{nullptr}, clock{100000}, txAddr{0}, txLen{0},
+      txOverflow{false}, rxLen{0}, rxIdx{0}
+{
+    resetStats();
+}
+
+void TwoWire::attach(I2CDevice& dev)
+{
+    if (nDevs < MAX_DEVICES) devs[nDevs++] = &dev;
+}
+
+void TwoWire::beginTransmission(const uint8_t addr)
+{
+    txAddr = addr;
+    txLen = 0;
+    txOverflow = false;
+}
+
+size_t TwoWire::write(const uint8_t b)
+{
+    if (txLen >= BUFFER_LENGTH) {
+        txOverflow = true;
+        return 0;
+    }
+    txBuf[txLen++] = b;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, const size_t n)
+{
+    size_t w {0};
+    for (size_t i=0; i<n; ++i) w += write(data[i]);
+    return w;
+}
+
+// Returns the same status codes as the AVR Wire library:
+// 0 success, 1 data too long for buffer, 2 NACK on address,
+// 3 NACK on data.
+uint8_t TwoWire::endTransmission(const uint8_t sendStop)
+{
+    if (txOverflow) return 1;
+    I2CDevice* dev = start(txAddr, false);
+    if (!dev) {
+        stop();
+        return 2;
+    }
+    ++st.writeTransfers;
+    uint8_t status {0};
+    for (uint8_t i=0; i<txLen; ++i) {
+        charge(9);
+        ++st.bytesWritten;
+        if (!dev->onWrite(txBuf[i])) {
+            ++st.dataNacks;
+            status = 3;
+            break;
+        }
+    }
+    if (sendStop || status) stop();
+    return status;
+}
+
+uint8_t TwoWire::requestFrom(const uint8_t addr, uint8_t qty, const uint8_t sendStop)
+{
+    rxIdx = rxLen = 0;
+    if (qty > BUFFER_LENGTH) qty = BUFFER_LENGTH;
+    I2CDevice* dev = start(addr, true);
+    if (dev) {
+        ++st.readTransfers;
+        for (uint8_t i=0; i<qty; ++i) {
+            charge(9);
+            ++st.bytesRead;
+            rxBuf[rxLen++] = dev->onRead();
+        }
+    }
+    if (sendStop || !dev) stop();
+    return rxLen;
+}
+
+bool TwoWire::rawWrite(const uint8_t addr, const uint8_t* data, const uint16_t n, const bool sendStop)
+{
+    I2CDevice* dev = start(addr, false);
+    if (!dev) {
+        stop();
+        return false;
+    }
+    ++st.writeTransfers;
+    for (uint16_t i=0; i<n; ++i) {
+        charge(9);
+        ++st.bytesWritten;
+        if (!dev->onWrite(data[i])) {
+            ++st.dataNacks;
+            stop();
+            return false;
+        }
+    }
+    if (sendStop) stop();
+    return true;
+}
+
+bool TwoWire::rawRead(const uint8_t addr, uint8_t* data, const uint16_t n, const bool sendStop)
+{
+    I2CDevice* dev = start(addr, true);
+    if (!dev) {
+        stop();
+        return false;
+    }
+    ++st.readTransfers;
+    for (uint16_t i=0; i<n; ++i) {
+        charge(9);
+        ++st.bytesRead;
+        data[i] = dev->onRead();
+    }
+    if (sendStop) stop();
+    return true;
+}
+
+// Issue a START (or a repeated START if the previous transfer did not
+// release the bus) and the address byte. Returns the device that
+// acknowledged, or nullptr.
+I2CDevice* TwoWire::start(const uint8_t addr, const bool read)
+{
+    ++st.starts;
+    if (active) ++st.repeatedStarts;
+    charge(1 + 9);
+    active = nullptr;
+    for (uint8_t i=0; i<nDevs; ++i) {
+        if (devs[i]->onStart(addr, read)) {
+            active = devs[i];
+            return active;
+        }
+    }
+    ++st.addrNacks;
+    return nullptr;
+}
+
+void TwoWire::stop()
+{
+    ++st.stops;
+    charge(1);
+    for (uint8_t i=0; i<nDevs; ++i) devs[i]->onStop();
+    active = nullptr;
+}
+
+void TwoWire::charge(const uint32_t bits)
+{
+    uint64_t us = (static_cast<uint64_t>(bits) * 1000000 + clock - 1) / clock;
+    st.busMicros += us;
+    hostAdvance(us);
+}
+
+// ---- Time library subset ----
+
+#define LEAP_YEAR(Y) ( ((1970+(Y))>0) && !((1970+(Y))%4) && ( ((1970+(Y))%100) || !((1970+(Y))%400) ) )
+static const uint8_t monthDays[] {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+void breakTime(const time_t timeInput, tmElements_t& tm)
+{
+    uint8_t year;
+    uint8_t month, monthLength;
+    uint32_t time;
+    unsigned long days;
+
+    time = static_cast<uint32_t>(timeInput);
+    tm.Second = time % 60;
+    time /= 60;
+    tm.Minute = time % 60;
+    time /= 60;
+    tm.Hour = time % 24;
+    time /= 24;
+    tm.Wday = ((time + 4) % 7) + 1;
+
+    year = 0;
+    days = 0;
+    while ((unsigned)(days += (LEAP_YEAR(year) ? 366 : 365)) <= time) year++;
+    tm.Year = year;
+
+    days -= LEAP_YEAR(year) ? 366 : 365;
+    time -= days;
+
+    for (month=0; month<12; month++) {
+        if (month == 1) monthLength = LEAP_YEAR(year) ? 29 : 28;
+        else monthLength = monthDays[month];
+        if (time >= monthLength) time -= monthLength;
+        else break;
+    }
+    tm.Month = month + 1;
+    tm.Day = time + 1;
+}
+
+time_t makeTime(const tmElements_t& tm)
+{
+    int i;
+    uint32_t seconds;
+
+    seconds = tm.Year * (SECS_PER_DAY * 365);
+    for (i = 0; i < tm.Year; i++) {
+        if (LEAP_YEAR(i)) seconds += SECS_PER_DAY;
+    }
+    for (i = 1; i < tm.Month; i++) {
+        if ((i == 2) && LEAP_YEAR(tm.Year)) seconds += SECS_PER_DAY * 29;
+        else seconds += SECS_PER_DAY * monthDays[i-1];
+    }
+    seconds += (tm.Day - 1) * SECS_PER_DAY;
+    seconds += tm.Hour * SECS_PER_HOUR;
+    seconds += tm.Minute * SECS_PER_MIN;
+    seconds += tm.Second;
+    return static_cast<time_t>(seconds);
+}
+
+static time_t sysTime;
+static uint32_t prevMillis;
+static uint32_t nextSyncTime;
+static time_t syncInterval {300};
+static timeStatus_t status {timeNotSet};
+static getExternalTime getTimePtr;
+
+time_t now()
+{
+    while (millis() - prevMillis >= 1000) {
+        ++sysTime;
+        prevMillis += 1000;
+    }
+    if (nextSyncTime <= sysTime && getTimePtr) {
+        time_t t = getTimePtr();
+        if (t != 0) {
+            setTime(t);
+        }
+        else {
+            nextSyncTime = sysTime + syncInterval;
+            status = (status == timeNotSet) ? timeNotSet : timeNeedsSync;
+        }
+    }
+    return sysTime;
+}
+
+void setTime(const time_t t)
+{
+    sysTime = t;
+    nextSyncTime = t + syncInterval;
+    status = timeSet;
+    prevMillis = millis();
+}
+
+timeStatus_t timeStatus()
+{
+    now();
+    return status;
+}
+
+void setSyncProvider(getExternalTime getTimeFunction)
+{
+    getTimePtr = getTimeFunction;
+    nextSyncTime = sysTime;
+    now();
+}
+
+void setSyncInterval(const time_t interval)
+{
+    syncInterval = interval;
+    nextSyncTime = sysTime + syncInterval;
+}
+
+static tmElements_t cacheTm(const time_t t)
+{
+    tmElements_t tm;
+    breakTime(t, tm);
+    return tm;
+}
+
+int year(const time_t t) {return tmYearToCalendar(cacheTm(t).Year);}
+int month(const time_t t) {return cacheTm(t).Month;}
+int day(const time_t t) {return cacheTm(t).Day;}
+int hour(const time_t t) {return cacheTm(t).Hour;}
+int minute(const time_t t) {return cacheTm(t).Minute;}
+int second(const time_t t) {return cacheTm(t).Second;}
+int weekday(const time_t t) {return cacheTm(t).Wday;}
@@ -0,0 +1,74 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// A fake Linux i2c-dev device for testing LinuxI2CTransport (see
+// MCP7941xLinuxI2C.h) on the host. Its ioctl() carries out I2C_RDWR
+// calls on a simulated TwoWire bus, so the devices attached to the bus
+// (e.g. MCP7941xSim) answer them, and the bus counters and virtual
+// clock work as with the Wire library. The messages of one call are
+// joined with repeated STARTs and end with a STOP, as in the kernel.
+// Failed calls return -1 and set errno as i2c-dev does (ENXIO for a
+// NACK). calls() counts the ioctl() calls.
+// This file is not part of the Arduino library build.
+
+#ifndef HOST_I2C_DEV_H_INCLUDED
+#define HOST_I2C_DEV_H_INCLUDED
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <MCP7941xLinuxI2C.h>
+
+class HostI2CDev
+{
+    public:
+        HostI2CDev(TwoWire& bus=Wire) : m_bus(bus) {current() = this;}
+        int fd() {return FD;}
+        uint32_t calls() {return m_calls;}
+        void resetCalls() {m_calls = 0;}
+        LinuxI2CTransport transport() {return LinuxI2CTransport(FD, ioctl);}
+
+        // the ioctl() for a LinuxI2CTransport, for the most recently
+        // constructed HostI2CDev
+        static int ioctl(int fd, unsigned long request, void* arg)
+        {
+            if (fd != FD || !current()) {
+                errno = EBADF;
+                return -1;
+            }
+            if (request != I2C_RDWR) {
+                errno = ENOTTY;
+                return -1;
+            }
+            return current()->rdwr(*static_cast<i2c_rdwr_ioctl_data*>(arg));
+        }
+
+    private:
+        static constexpr int FD {42};
+        TwoWire& m_bus;
+        uint32_t m_calls {0};
+
+        static HostI2CDev*& current()
+        {
+            static HostI2CDev* dev {nullptr};
+            return dev;
+        }
+
+        int rdwr(const i2c_rdwr_ioctl_data& data)
+        {
+            ++m_calls;
+            for (uint32_t i=0; i<data.nmsgs; ++i) {
+                const i2c_msg& m = data.msgs[i];
+                bool last {i == data.nmsgs - 1};
+                bool ok = m.flags & I2C_M_RD ? m_bus.rawRead(m.addr, m.buf, m.len, last)
+                    : m_bus.rawWrite(m.addr, m.buf, m.len, last);
+                if (!ok) {
+                    errno = ENXIO;
+                    return -1;
+                }
+            }
+            return data.nmsgs;
+        }
+};
+#endif
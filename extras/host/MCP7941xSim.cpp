@@ -0,0 +1,456 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Register-level model of the Microchip MCP79411/12, see MCP7941xSim.h.
+// This file is not part of the Arduino library build.
+
+#include <MCP7941xSim.h>
+
+namespace {
+    // register addresses and bits, as in MCP79412RTC.h
+    constexpr uint8_t
+        RTCSEC {0x00}, RTCMIN {0x01}, RTCHOUR {0x02}, RTCWKDAY {0x03},
+        RTCDATE {0x04}, RTCMTH {0x05}, RTCYEAR {0x06}, CONTROL {0x07},
+        OSCTRIM {0x08}, EEUNLOCK {0x09}, ALM0SEC {0x0A}, ALM1SEC {0x11},
+        ALMWKDAY {3},   // offset of ALMxWKDAY from ALMxSEC
+        ALM0RSVD {0x10}, ALM1RSVD {0x17}, PWRDNMIN {0x18}, PWRUPMIN {0x1C},
+        STOSC {7}, OSCRUN {5}, PWRFAIL {4}, VBATEN {3}, LPYR {5},
+        OUT {7}, SQWEN {6}, ALM0EN {4}, CRSTRIM {2},
+        ALMPOL {7}, ALMxIF {3};
+
+    // one OSCTRIM step adds or subtracts two oscillator clocks per minute
+    // (fine trim) or 128 times per second (coarse trim)
+    constexpr double TRIM_PPM {2.0 / 32768.0 / 60.0 * 1e6};
+    constexpr double COARSE_FACTOR {128.0 * 60.0};
+
+    const uint8_t defaultID[] {0x00, 0x04, 0xA3, 0x12, 0x34, 0x56, 0x78, 0x9A};
+}
+
+MCP7941xSim::MCP7941xSim(TwoWire& bus)
+{
+    reset();
+    bus.attach(*this);
+}
+
+// Factory state: registers and SRAM cleared, oscillator stopped, EEPROM
+// erased, default EUI-64, Vcc applied, no crystal error.
+void MCP7941xSim::reset()
+{
+    memset(r, 0, sizeof r);
+    r[CONTROL] = _BV(OUT);
+    memset(ee, 0xFF, sizeof ee);
+    memcpy(id, defaultID, sizeof id);
+    eeStatus = 0;
+    vcc = true;
+    unlockArmed = unlocked = false;
+    xtalPpm = 0;
+    lastSync = hostMicros();
+    subMicros = 0;
+    eeBusyUntil = 0;
+    target = NONE;
+    reading = ptrSet = false;
+    rtcPtr = eePtr = 0;
+    pageLen = 0;
+    almMatch[0] = almMatch[1] = false;
+    resetCounters();
+}
+
+void MCP7941xSim::resetCounters()
+{
+    memset(&rtcCnt, 0, sizeof rtcCnt);
+    memset(&eeCnt, 0, sizeof eeCnt);
+}
+
+bool MCP7941xSim::onStart(const uint8_t addr, const bool read)
+{
+    if (addr != RTC_ADDR && addr != EEPROM_ADDR) return false;
+    sync();
+    target = (addr == RTC_ADDR) ? RTC : EEPROM;
+    if (!vcc || (target == EEPROM && eepromBusy())) {
+        ++counters().nacks;
+        target = NONE;
+        return false;
+    }
+    reading = read;
+    ptrSet = false;
+    pageLen = 0;
+    if (read) ++counters().reads;
+    else ++counters().writes;
+    return true;
+}
+
+bool MCP7941xSim::onWrite(const uint8_t b)
+{
+    if (target == NONE) return false;
+    ++counters().bytesWritten;
+    if (target == RTC) {
+        if (!ptrSet) rtcPtr = b % RTC_REG_SIZE;
+        else {
+            writeReg(rtcPtr, b);
+            rtcPtr = (rtcPtr + 1) % RTC_REG_SIZE;
+        }
+    }
+    else {
+        if (!ptrSet) {
+            eePtr = b;
+            pageBase = b & ~(EEPROM_PAGE_SIZE - 1);
+            pageStart = b & (EEPROM_PAGE_SIZE - 1);
+        }
+        else {
+            // the page buffer wraps, later bytes overwrite earlier ones
+            pageBuf[(pageStart + pageLen) & (EEPROM_PAGE_SIZE - 1)] = b;
+            if (pageLen < 0xFF) ++pageLen;
+        }
+    }
+    ptrSet = true;
+    return true;
+}
+
+uint8_t MCP7941xSim::onRead()
+{
+    if (target == NONE) return 0xFF;
+    ++counters().bytesRead;
+    uint8_t v;
+    if (target == RTC) {
+        // the clock was brought up to date at START; like the device,
+        // a burst read sees one consistent set of time registers.
+        v = (rtcPtr == EEUNLOCK) ? 0 : r[rtcPtr];
+        rtcPtr = (rtcPtr + 1) % RTC_REG_SIZE;
+    }
+    else {
+        if (eePtr < EEPROM_SIZE) {
+            v = ee[eePtr];
+            eePtr = (eePtr + 1) & (EEPROM_SIZE - 1);
+        }
+        else if (eePtr >= UNIQUE_ID_ADDR && eePtr < UNIQUE_ID_ADDR + UNIQUE_ID_SIZE) {
+            v = id[eePtr - UNIQUE_ID_ADDR];
+            eePtr = UNIQUE_ID_ADDR + ((eePtr + 1) & (UNIQUE_ID_SIZE - 1));
+        }
+        else {
+            v = (eePtr == EEPROM_STATUS) ? eeStatus : 0xFF;
+            ++eePtr;
+        }
+    }
+    return v;
+}
+
+void MCP7941xSim::onStop()
+{
+    if (target == EEPROM && !reading && pageLen > 0) commitPage();
+    if (target == RTC && !reading && mfpIrq != 0xFF) onEvent();    // e.g. a flag was cleared
+    target = NONE;
+    pageLen = 0;
+}
+
+uint8_t MCP7941xSim::reg(const uint8_t addr)
+{
+    sync();
+    if (addr == EEUNLOCK || addr >= RTC_REG_SIZE) return 0;
+    return r[addr];
+}
+
+// Set a register directly, bypassing the write rules for read-only and
+// clear-only bits. Intended for setting up test conditions.
+void MCP7941xSim::setReg(const uint8_t addr, const uint8_t value)
+{
+    sync();
+    if (addr < RTC_REG_SIZE) r[addr] = value;
+}
+
+void MCP7941xSim::setUniqueID(const uint8_t* uid)
+{
+    memcpy(id, uid, sizeof id);
+}
+
+// Oscillator rate error in ppm including the effect of OSCTRIM.
+// A set sign bit adds clocks (speeds the clock up).
+double MCP7941xSim::ratePpm()
+{
+    uint8_t trim = r[OSCTRIM];
+    double t = (trim & 0x7F) * TRIM_PPM;
+    if (r[CONTROL] & _BV(CRSTRIM)) t *= COARSE_FACTOR;
+    return xtalPpm + ((trim & 0x80) ? t : -t);
+}
+
+// Level of the multi-function pin.
+bool MCP7941xSim::mfp()
+{
+    sync();
+    uint8_t ctrl = r[CONTROL];
+    if (ctrl & _BV(SQWEN)) {
+        static const double hz[] {1, 4096, 8192, 32768};
+        double period = 1e6 / hz[ctrl & 0x03];
+        return fmod(subMicros, period) < period / 2;
+    }
+    bool en0 = ctrl & _BV(ALM0EN);
+    bool en1 = ctrl & _BV(ALM0EN + 1);
+    if (!en0 && !en1) return ctrl & _BV(OUT);
+    bool pol = r[ALM0SEC + ALMWKDAY] & _BV(ALMPOL);
+    bool level {false};
+    if (en0) level |= (r[ALM0SEC + ALMWKDAY] & _BV(ALMxIF)) ? pol : !pol;
+    if (en1) level |= (r[ALM1SEC + ALMWKDAY] & _BV(ALMxIF)) ? pol : !pol;
+    return level;
+}
+
+// Connect the MFP to the given interrupt (see attachInterrupt()).
+void MCP7941xSim::connectMfp(const uint8_t interruptNum)
+{
+    if (mfpIrq == 0xFF) hostAddTimer(this);
+    mfpIrq = interruptNum;
+    mfpLevel = mfp();
+}
+
+// Virtual time of the next possible change of the MFP level: the next
+// half period of the square wave, or the next second if an alarm is
+// enabled.
+uint64_t MCP7941xSim::nextEvent()
+{
+    if (mfpIrq == 0xFF) return UINT64_MAX;
+    sync();
+    uint8_t ctrl = r[CONTROL];
+    if ( !(r[RTCSEC] & _BV(STOSC)) ) return UINT64_MAX;
+    double rtcUs;
+    if (ctrl & _BV(SQWEN)) {
+        static const double hz[] {1, 4096, 8192, 32768};
+        double half = 5e5 / hz[ctrl & 0x03];
+        rtcUs = half - fmod(subMicros, half);
+    }
+    else if (ctrl & (_BV(ALM0EN) | _BV(ALM0EN + 1))) {
+        rtcUs = 1e6 - subMicros;
+    }
+    else {
+        return UINT64_MAX;
+    }
+    double us = ceil(rtcUs / (1.0 + ratePpm() * 1e-6));
+    return hostMicros() + (us < 1 ? 1 : static_cast<uint64_t>(us));
+}
+
+void MCP7941xSim::onEvent()
+{
+    bool level = mfp();
+    if (level != mfpLevel) {
+        mfpLevel = level;
+        hostPinChange(mfpIrq, level);
+    }
+}
+
+void MCP7941xSim::powerDown()
+{
+    sync();
+    if (!vcc) return;
+    vcc = false;
+    target = NONE;
+    if (r[RTCWKDAY] & _BV(VBATEN)) {
+        if ( !(r[RTCWKDAY] & _BV(PWRFAIL)) ) stamp(PWRDNMIN);
+    }
+    else {
+        // no backup, the registers and SRAM are lost
+        uint8_t ctrl = _BV(OUT);
+        memset(r, 0, sizeof r);
+        r[CONTROL] = ctrl;
+        subMicros = 0;
+    }
+}
+
+void MCP7941xSim::powerUp()
+{
+    sync();
+    if (vcc) return;
+    vcc = true;
+    if ( (r[RTCWKDAY] & _BV(VBATEN)) && !(r[RTCWKDAY] & _BV(PWRFAIL)) ) {
+        stamp(PWRUPMIN);
+        r[RTCWKDAY] |= _BV(PWRFAIL);
+    }
+}
+
+// Bring the oscillator up to the current host time.
+void MCP7941xSim::sync()
+{
+    uint64_t t = hostMicros();
+    uint64_t dt = t - lastSync;
+    lastSync = t;
+    if ( !(r[RTCSEC] & _BV(STOSC)) ) return;
+    subMicros += dt * (1.0 + ratePpm() * 1e-6);
+    while (subMicros >= 1e6) {
+        subMicros -= 1e6;
+        tick();
+    }
+}
+
+// Advance the clock/calendar by one second.
+void MCP7941xSim::tick()
+{
+    static const uint8_t monthDays[] {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    uint8_t s = dec(r[RTCSEC] & 0x7F) + 1;
+    if (s < 60) {
+        r[RTCSEC] = (r[RTCSEC] & 0x80) | bcd(s);
+    }
+    else {
+        r[RTCSEC] &= 0x80;
+        uint8_t m = dec(r[RTCMIN] & 0x7F) + 1;
+        if (m < 60) {
+            r[RTCMIN] = bcd(m);
+        }
+        else {
+            r[RTCMIN] = 0;
+            uint8_t h = dec(r[RTCHOUR] & 0x3F) + 1;
+            if (h < 24) {
+                r[RTCHOUR] = (r[RTCHOUR] & 0x40) | bcd(h);
+            }
+            else {
+                r[RTCHOUR] &= 0x40;
+                uint8_t wd = r[RTCWKDAY] & 0x07;
+                r[RTCWKDAY] = (r[RTCWKDAY] & 0xF8) | (wd % 7 + 1);
+                uint8_t mth = dec(r[RTCMTH] & 0x1F);
+                uint8_t yr = dec(r[RTCYEAR]);
+                uint8_t dim = (mth >= 1 && mth <= 12) ? monthDays[mth - 1] : 31;
+                if (mth == 2 && yr % 4 == 0) dim = 29;
+                uint8_t d = dec(r[RTCDATE] & 0x3F) + 1;
+                if (d <= dim) {
+                    r[RTCDATE] = bcd(d);
+                }
+                else {
+                    r[RTCDATE] = 1;
+                    if (++mth > 12) {
+                        mth = 1;
+                        yr = (yr + 1) % 100;
+                        r[RTCYEAR] = bcd(yr);
+                    }
+                    r[RTCMTH] = bcd(mth) | ((yr % 4 == 0) ? _BV(LPYR) : 0);
+                }
+            }
+        }
+    }
+    checkAlarm(0);
+    checkAlarm(1);
+}
+
+// Set the alarm flag when the alarm's match condition becomes true.
+void MCP7941xSim::checkAlarm(const uint8_t n)
+{
+    uint8_t* a = r + (n ? ALM1SEC : ALM0SEC);
+    bool match;
+    switch ( (a[ALMWKDAY] >> 4) & 0x07 ) {
+        case 0: match = (a[0] & 0x7F) == (r[RTCSEC] & 0x7F); break;
+        case 1: match = (a[1] & 0x7F) == (r[RTCMIN] & 0x7F); break;
+        case 2: match = (a[2] & 0x7F) == (r[RTCHOUR] & 0x7F); break;
+        case 3: match = (a[ALMWKDAY] & 0x07) == (r[RTCWKDAY] & 0x07); break;
+        case 4: match = (a[4] & 0x3F) == (r[RTCDATE] & 0x3F); break;
+        case 7:
+            match = (a[0] & 0x7F) == (r[RTCSEC] & 0x7F)
+                && (a[1] & 0x7F) == (r[RTCMIN] & 0x7F)
+                && (a[2] & 0x7F) == (r[RTCHOUR] & 0x7F)
+                && (a[ALMWKDAY] & 0x07) == (r[RTCWKDAY] & 0x07)
+                && (a[4] & 0x3F) == (r[RTCDATE] & 0x3F)
+                && (a[5] & 0x1F) == (r[RTCMTH] & 0x1F);
+            break;
+        default: match = false; break;
+    }
+    if ( match && !almMatch[n] && (r[CONTROL] & _BV(ALM0EN + n)) ) {
+        a[ALMWKDAY] |= _BV(ALMxIF);
+    }
+    almMatch[n] = match;
+}
+
+// Register write from the bus, applying read-only and clear-only bits.
+void MCP7941xSim::writeReg(const uint8_t addr, const uint8_t value)
+{
+    uint8_t old = r[addr];
+    switch (addr) {
+        case RTCSEC:
+            sync();             // up to the time of this byte
+            r[addr] = value;
+            subMicros = 0;      // writing the seconds restarts the second
+            if (value & _BV(STOSC)) r[RTCWKDAY] |= _BV(OSCRUN);
+            else r[RTCWKDAY] &= ~_BV(OSCRUN);
+            break;
+        case RTCWKDAY:
+            r[addr] = (value & 0x0F & ~_BV(PWRFAIL))
+                | (old & _BV(OSCRUN)) | (old & value & _BV(PWRFAIL));
+            if ( (old & _BV(PWRFAIL)) && !(value & _BV(PWRFAIL)) ) {
+                memset(r + PWRDNMIN, 0, 8);     // clearing PWRFAIL clears the timestamps
+            }
+            break;
+        case RTCMTH:
+            r[addr] = (value & 0x1F) | (old & _BV(LPYR));
+            break;
+        case RTCYEAR:
+            r[addr] = value;
+            r[RTCMTH] = (r[RTCMTH] & 0x1F) | ((dec(value) % 4 == 0) ? _BV(LPYR) : 0);
+            break;
+        case EEUNLOCK:
+            if (value == 0x55) {
+                unlockArmed = true;
+            }
+            else {
+                unlocked = unlockArmed && value == 0xAA;
+                unlockArmed = false;
+            }
+            break;
+        case ALM0SEC + ALMWKDAY:
+        case ALM1SEC + ALMWKDAY:
+            r[addr] = (value & ~_BV(ALMxIF)) | (old & value & _BV(ALMxIF));
+            break;
+        case ALM0RSVD:
+        case ALM1RSVD:
+            break;
+        default:
+            if (addr >= PWRDNMIN && addr < PWRDNMIN + 8) break;     // timestamps are read-only
+            r[addr] = value;
+            break;
+    }
+}
+
+// End of an EEPROM write transfer: a single data byte to the STATUS
+// register sets block protection, anything else is a page write.
+void MCP7941xSim::commitPage()
+{
+    if (eePtr == EEPROM_STATUS) {
+        eeStatus = pageBuf[pageStart] & 0x0C;
+    }
+    else if (eePtr >= UNIQUE_ID_ADDR && eePtr < UNIQUE_ID_ADDR + UNIQUE_ID_SIZE) {
+        if (!unlocked) return;
+        unlocked = false;
+        uint8_t n = pageLen < EEPROM_PAGE_SIZE ? pageLen : EEPROM_PAGE_SIZE;
+        for (uint8_t i=0; i<n; ++i) {
+            uint8_t o = (pageStart + i) & (EEPROM_PAGE_SIZE - 1);
+            id[o] = pageBuf[o];
+        }
+    }
+    else if (eePtr < EEPROM_SIZE) {
+        uint8_t n = pageLen < EEPROM_PAGE_SIZE ? pageLen : EEPROM_PAGE_SIZE;
+        for (uint8_t i=0; i<n; ++i) {
+            uint8_t o = (pageStart + i) & (EEPROM_PAGE_SIZE - 1);
+            if ( eeWritable(pageBase + o) ) ee[pageBase + o] = pageBuf[o];
+        }
+    }
+    else {
+        return;
+    }
+    ++eeCnt.pageWrites;
+    eeBusyUntil = hostMicros() + EEPROM_WRITE_MICROS;
+}
+
+// Block protection: BP1:BP0 == 1 protects the upper quarter of the
+// array, 2 the upper half, 3 all of it.
+bool MCP7941xSim::eeWritable(const uint8_t addr)
+{
+    switch ( (eeStatus >> 2) & 0x03 ) {
+        case 1: return addr < 0x60;
+        case 2: return addr < 0x40;
+        case 3: return false;
+        default: return true;
+    }
+}
+
+// Capture a power-fail timestamp: minutes, hours, date, weekday/month.
+void MCP7941xSim::stamp(const uint8_t base)
+{
+    r[base] = r[RTCMIN];
+    r[base + 1] = r[RTCHOUR];
+    r[base + 2] = r[RTCDATE];
+    r[base + 3] = ((r[RTCWKDAY] & 0x07) << 5) | (r[RTCMTH] & 0x1F);
+}
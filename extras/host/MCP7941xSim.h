@@ -0,0 +1,141 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Register-level model of the Microchip MCP79411/12 for running the
+// library on a Linux host. Attach it to a (host) TwoWire bus and pass
+// that bus to MCP79412RTC; the library code runs unmodified.
+//
+// What is modeled:
+//  - RTCC registers and SRAM, 0x00-0x5F at 0x6F. The register pointer
+//    rolls over from 0x5F to 0x00.
+//  - The oscillator, started and stopped by STOSC, with OSCRUN
+//    following it. Time advances with the host's virtual clock, at a
+//    rate set by the crystal error and the OSCTRIM/CRSTRIM trim.
+//    Writing RTCSEC restarts the current second, from when the data
+//    byte is written.
+//  - Calendar rollover including the leap year bit (LPYR) and the
+//    day of week.
+//  - Both alarms, with all the ALMxMSK match modes, the ALMxIF flags,
+//    and the MFP output level (OUT, ALMPOL and square wave enable).
+//    connectMfp() wires the MFP to an interrupt: each change of level
+//    calls the attached handler, at the exact virtual time.
+//  - Power failure: while powered down the device does not respond on
+//    the bus. If VBATEN is set, time keeps running and the power-down
+//    and power-up timestamps are captured and PWRFAIL is set, otherwise
+//    the device loses its registers and SRAM.
+//  - 128 bytes of EEPROM at 0x57 with 8-byte page buffers (the address
+//    wraps within the page), a 5ms write cycle during which the EEPROM
+//    does not acknowledge its address, the STATUS register at 0xFF with
+//    the block protect bits, and the unique ID at 0xF0-0xF7 which can
+//    only be written after the EEUNLOCK sequence.
+//
+// Hardware-owned flag bits (OSCRUN, LPYR, PWRFAIL, ALMxIF) can be
+// cleared but not set by a write. This file is not part of the Arduino
+// library build.
+
+#ifndef MCP7941X_SIM_H_INCLUDED
+#define MCP7941X_SIM_H_INCLUDED
+
+#include <Wire.h>
+
+class MCP7941xSim : public I2CDevice, public HostTimer
+{
+    public:
+        static constexpr uint8_t
+            RTC_ADDR        {0x6F},
+            EEPROM_ADDR     {0x57},
+            RTC_REG_SIZE    {0x60},     // registers plus SRAM
+            EEPROM_SIZE     {128},
+            EEPROM_PAGE_SIZE{8},
+            UNIQUE_ID_ADDR  {0xF0},
+            UNIQUE_ID_SIZE  {8},
+            EEPROM_STATUS   {0xFF};
+        static constexpr uint32_t EEPROM_WRITE_MICROS {5000};
+
+        // Per-device transaction counts, one entry per I2C address.
+        struct Counters {
+            uint32_t writes;        // addressed write transfers
+            uint32_t reads;         // addressed read transfers
+            uint32_t bytesWritten;
+            uint32_t bytesRead;
+            uint32_t nacks;         // address NACKs (EEPROM busy or powered down)
+            uint32_t pageWrites;    // EEPROM write cycles started
+        };
+
+        MCP7941xSim(TwoWire& bus=Wire);
+        void reset();
+
+        // I2CDevice
+        bool onStart(const uint8_t addr, const bool read);
+        bool onWrite(const uint8_t b);
+        uint8_t onRead();
+        void onStop();
+
+        // direct (non-bus) access for test setup and checking
+        uint8_t reg(const uint8_t addr);
+        void setReg(const uint8_t addr, const uint8_t value);
+        uint8_t eeprom(const uint8_t addr) {return ee[addr & (EEPROM_SIZE - 1)];}
+        void setEeprom(const uint8_t addr, const uint8_t value) {ee[addr & (EEPROM_SIZE - 1)] = value;}
+        void setUniqueID(const uint8_t* id);
+        void setCrystalPpm(const double ppm) {xtalPpm = ppm;}
+        double ratePpm();
+        bool eepromBusy() {return hostMicros() < eeBusyUntil;}
+        bool mfp();
+        void connectMfp(const uint8_t interruptNum);
+
+        // HostTimer, for changes of the MFP level
+        uint64_t nextEvent();
+        void onEvent();
+
+        // power supply
+        void powerDown();
+        void powerUp();
+        bool powered() {return vcc;}
+
+        // statistics
+        const Counters& rtcCounters() const {return rtcCnt;}
+        const Counters& eepromCounters() const {return eeCnt;}
+        void resetCounters();
+
+    private:
+        enum target_t {NONE, RTC, EEPROM};
+        uint8_t r[RTC_REG_SIZE];
+        uint8_t ee[EEPROM_SIZE];
+        uint8_t id[UNIQUE_ID_SIZE];
+        uint8_t eeStatus;
+        bool vcc;
+        bool unlockArmed;           // 0x55 was written to EEUNLOCK
+        bool unlocked;              // 0x55, 0xAA sequence complete
+        double xtalPpm;
+        uint64_t lastSync;          // host micros at last oscillator update
+        double subMicros;           // elapsed RTC micros in the current second
+        uint64_t eeBusyUntil;
+        target_t target;
+        bool reading;
+        bool ptrSet;                // the first (address) byte has been received
+        uint8_t rtcPtr;
+        uint8_t eePtr;
+        uint8_t pageBuf[EEPROM_PAGE_SIZE];
+        uint8_t pageBase;
+        uint8_t pageStart;
+        uint8_t pageLen;            // bytes received for the page write
+        bool almMatch[2];           // alarm match state at the last tick
+        uint8_t mfpIrq {0xFF};      // interrupt the MFP is connected to
+        bool mfpLevel;              // MFP level last reported
+        Counters rtcCnt, eeCnt;
+
+        void sync();
+        void tick();
+        void checkAlarm(const uint8_t n);
+        void writeReg(const uint8_t addr, const uint8_t value);
+        void commitPage();
+        bool eeWritable(const uint8_t addr);
+        void stamp(const uint8_t base);
+        Counters& counters() {return target == RTC ? rtcCnt : eeCnt;}
+        static uint8_t bcd(const uint8_t n) {return n + 6 * (n / 10);}
+        static uint8_t dec(const uint8_t n) {return n - 6 * (n >> 4);}
+};
+
+#endif
@@ -0,0 +1,59 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Host (Linux) stand-in for the subset of PJRC's Time library
+// (https://github.com/PaulStoffregen/Time) that this library uses.
+// makeTime() and breakTime() use the same year/month loops as the
+// real library so that host timings are representative.
+// This file is not part of the Arduino library build.
+
+#ifndef HOST_TIMELIB_H_INCLUDED
+#define HOST_TIMELIB_H_INCLUDED
+
+#include <Arduino.h>
+#include <time.h>
+
+enum timeStatus_t {timeNotSet, timeNeedsSync, timeSet};
+
+typedef struct {
+    uint8_t Second;
+    uint8_t Minute;
+    uint8_t Hour;
+    uint8_t Wday;   // day of week, sunday is day 1
+    uint8_t Day;
+    uint8_t Month;
+    uint8_t Year;   // offset from 1970
+} tmElements_t;
+
+enum {tmSecond, tmMinute, tmHour, tmWday, tmDay, tmMonth, tmYear, tmNbrFields};
+
+typedef time_t (*getExternalTime)();
+
+#define SECS_PER_MIN  (60UL)
+#define SECS_PER_HOUR (3600UL)
+#define SECS_PER_DAY  (SECS_PER_HOUR * 24UL)
+#define tmYearToCalendar(Y) ((Y) + 1970)
+#define CalendarYrToTm(Y)   ((Y) - 1970)
+#define tmYearToY2k(Y)      ((Y) - 30)
+#define y2kYearToTm(Y)      ((Y) + 30)
+
+time_t makeTime(const tmElements_t& tm);
+void breakTime(const time_t time, tmElements_t& tm);
+
+time_t now();
+void setTime(const time_t t);
+timeStatus_t timeStatus();
+void setSyncProvider(getExternalTime getTimeFunction);
+void setSyncInterval(const time_t interval);
+
+int year(const time_t t);
+int month(const time_t t);
+int day(const time_t t);
+int hour(const time_t t);
+int minute(const time_t t);
+int second(const time_t t);
+int weekday(const time_t t);
+
+#endif
@@ -0,0 +1,98 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Host (Linux) stand-in for the Arduino Wire library. TwoWire has the
+// same API and the same buffer limits as the AVR Wire library, but
+// instead of driving pins it delivers each transaction to simulated
+// I2C devices attached to the bus, and counts what it costs.
+// Bus time is charged to the virtual clock (see Arduino.h) at 9 bit
+// times per byte plus one bit time each for START and STOP.
+// This file is not part of the Arduino library build.
+
+#ifndef HOST_WIRE_H_INCLUDED
+#define HOST_WIRE_H_INCLUDED
+
+#include <Arduino.h>
+
+#ifndef BUFFER_LENGTH
+#define BUFFER_LENGTH 32
+#endif
+
+// A simulated I2C target. A device may answer at more than one address.
+class I2CDevice
+{
+    public:
+        virtual ~I2CDevice() {}
+        // START (or repeated START) with the given address. Return true to ACK.
+        virtual bool onStart(const uint8_t addr, const bool read) = 0;
+        // A byte written by the controller. Return true to ACK.
+        virtual bool onWrite(const uint8_t b) = 0;
+        // A byte read by the controller.
+        virtual uint8_t onRead() = 0;
+        // STOP condition.
+        virtual void onStop() = 0;
+};
+
+class TwoWire
+{
+    public:
+        // Cumulative bus statistics, see resetStats().
+        struct Stats {
+            uint32_t starts;            // START plus repeated START conditions
+            uint32_t repeatedStarts;    // repeated START conditions only
+            uint32_t stops;             // STOP conditions
+            uint32_t writeTransfers;    // address-write phases
+            uint32_t readTransfers;     // address-read phases
+            uint32_t bytesWritten;      // data bytes written, excluding address bytes
+            uint32_t bytesRead;         // data bytes read, excluding address bytes
+            uint32_t addrNacks;         // transfers not acknowledged by any device
+            uint32_t dataNacks;         // data bytes not acknowledged
+            uint64_t busMicros;         // time the bus was busy
+        };
+
+        TwoWire();
+        void begin() {}
+        void end() {}
+        void setClock(const uint32_t hz) {clock = hz;}
+        void attach(I2CDevice& dev);
+        void beginTransmission(const uint8_t addr);
+        size_t write(const uint8_t b);
+        size_t write(const uint8_t* data, const size_t n);
+        uint8_t endTransmission(const uint8_t sendStop=true);
+        uint8_t requestFrom(const uint8_t addr, const uint8_t qty, const uint8_t sendStop=true);
+        int available() {return rxLen - rxIdx;}
+        int read() {return rxIdx < rxLen ? rxBuf[rxIdx++] : -1;}
+        int peek() {return rxIdx < rxLen ? rxBuf[rxIdx] : -1;}
+        // Unbuffered transfers of any length, as by a Linux I2C adapter
+        // (see HostI2CDev.h). Return false on a NACK, after a STOP.
+        bool rawWrite(const uint8_t addr, const uint8_t* data, const uint16_t n, const bool sendStop=true);
+        bool rawRead(const uint8_t addr, uint8_t* data, const uint16_t n, const bool sendStop=true);
+
+        const Stats& stats() const {return st;}
+        void resetStats() {memset(&st, 0, sizeof st);}
+
+    private:
+        static constexpr uint8_t MAX_DEVICES {8};
+        I2CDevice* devs[MAX_DEVICES];
+        uint8_t nDevs;
+        I2CDevice* active;      // device holding the bus after a repeated start
+        uint32_t clock;
+        Stats st;
+        uint8_t txAddr;
+        uint8_t txBuf[BUFFER_LENGTH];
+        uint8_t txLen;
+        bool txOverflow;
+        uint8_t rxBuf[BUFFER_LENGTH];
+        uint8_t rxLen;
+        uint8_t rxIdx;
+
+        I2CDevice* start(const uint8_t addr, const bool read);
+        void stop();
+        void charge(const uint32_t bits);
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,102 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Host program that runs each MCP79412RTC function against the
+// MCP7941x simulator and reports what it costs on the I2C bus.
+// See README.md in this directory for how to build it. Build it with
+// -DMCP79412_STATS to print the library's bus statistics too.
+
+#include <MCP79412RTC.h>
+#include <MCP7941xSim.h>
+#include <stdio.h>
+
+MCP7941xSim sim;
+MCP79412RTC myRTC;
+
+// Print one row of the report: bus statistics accumulated since the
+// last call, then reset them.
+void report(const char* name)
+{
+    const TwoWire::Stats& s = Wire.stats();
+    printf("%-28s %6u %6u %6u %6u %6u %8llu\n", name,
+        static_cast<unsigned>(s.starts), static_cast<unsigned>(s.stops),
+        static_cast<unsigned>(s.bytesWritten), static_cast<unsigned>(s.bytesRead),
+        static_cast<unsigned>(s.addrNacks), static_cast<unsigned long long>(s.busMicros));
+    Wire.resetStats();
+}
+
+int main()
+{
+    uint8_t buf[128];
+    time_t t1, t2;
+    tmElements_t tm;
+
+    myRTC.begin();
+    printf("%-28s %6s %6s %6s %6s %6s %8s\n", "function", "starts", "stops",
+        "wrote", "read", "nacks", "bus_us");
+    Wire.resetStats();
+
+    myRTC.set(1735689600);              report("set(time_t)");
+    myRTC.get();                        report("get()");
+    myRTC.read(tm);                     report("read(tm)");
+    myRTC.write(tm);                    report("write(tm)");
+    myRTC.isRunning();                  report("isRunning()");
+    myRTC.readRTC(MCP79412RTC::CONTROL);        report("readRTC(addr)");
+    myRTC.writeRTC(MCP79412RTC::CONTROL, 0x80); report("writeRTC(addr, value)");
+    myRTC.sramWrite(0, 0x42);           report("sramWrite(addr, value)");
+    myRTC.sramWrite(0, buf, 31);        report("sramWrite(0, buf, 31)");
+    myRTC.sramRead(0);                  report("sramRead(addr)");
+    myRTC.sramRead(0, buf, 32);         report("sramRead(0, buf, 32)");
+    myRTC.sramWrite(0, buf, 64);        report("sramWrite(0, buf, 64)");
+    myRTC.sramRead(0, buf, 64);         report("sramRead(0, buf, 64)");
+    myRTC.readRTC(0, buf, 96);          report("readRTC(0, buf, 96)");
+    myRTC.eepromWrite(0, 0x42);         report("eepromWrite(addr, value)");
+    myRTC.eepromWrite(0, buf, 8);       report("eepromWrite(0, buf, 8)");
+    myRTC.eepromRead(0);                report("eepromRead(addr)");
+    myRTC.eepromRead(0, buf, 32);       report("eepromRead(0, buf, 32)");
+    myRTC.eepromWriteBulk(0, buf, 128); report("eepromWriteBulk(0, buf, 128)");
+    myRTC.eepromWriteBulk(5, buf, 20);  report("eepromWriteBulk(5, buf, 20)");
+    myRTC.eepromReadBulk(0, buf, 128);  report("eepromReadBulk(0, buf, 128)");
+    myRTC.calibRead();                  report("calibRead()");
+    myRTC.calibWrite(-10);              report("calibWrite(value)");
+    myRTC.idRead(buf);                  report("idRead()");
+    myRTC.getEUI64(buf);                report("getEUI64()");
+    myRTC.powerFail(&t1, &t2);          report("powerFail() no outage");
+    sim.powerDown();
+    hostAdvance(3600000000ULL);
+    sim.powerUp();
+    Wire.resetStats();
+    myRTC.powerFail(&t1, &t2);          report("powerFail() outage");
+    myRTC.squareWave(MCP79412RTC::SQWAVE_1_HZ);     report("squareWave()");
+    myRTC.setAlarm(MCP79412RTC::ALARM_0, 1735689660);   report("setAlarm(time_t)");
+    myRTC.setAlarm(MCP79412RTC::ALARM_1, 2025, 1, 1, 0, 2, 0);  report("setAlarm(y, mon, d, ...)");
+    myRTC.enableAlarm(MCP79412RTC::ALARM_0, MCP79412RTC::ALM_MATCH_MINUTES);    report("enableAlarm()");
+    myRTC.alarm(MCP79412RTC::ALARM_0);  report("alarm() not triggered");
+    hostAdvance(120000000ULL);
+    Wire.resetStats();
+    myRTC.alarm(MCP79412RTC::ALARM_0);  report("alarm() triggered");
+    myRTC.out(HIGH);                    report("out()");
+    myRTC.alarmPolarity(HIGH);          report("alarmPolarity()");
+    myRTC.vbaten(true);                 report("vbaten()");
+    MCP79412RTC::SNAPSHOT_t snap;
+    myRTC.snapshot(snap);               report("snapshot()");
+    myRTC.clearAlarmFlags(snap);        report("clearAlarmFlags() both");
+
+    // the same configuration functions with the register shadow enabled
+    myRTC.shadowRegisters(true);
+    myRTC.begin();                      report("begin() with shadow");
+    myRTC.squareWave(MCP79412RTC::SQWAVE_NONE);     report("squareWave() shadow");
+    myRTC.setAlarm(MCP79412RTC::ALARM_0, 1735689660);   report("setAlarm(time_t) shadow");
+    myRTC.enableAlarm(MCP79412RTC::ALARM_0, MCP79412RTC::ALM_MATCH_MINUTES);    report("enableAlarm() shadow");
+    myRTC.out(LOW);                     report("out() shadow");
+    myRTC.alarmPolarity(LOW);           report("alarmPolarity() shadow");
+
+#ifdef MCP79412_STATS
+    // the library's own statistics for the whole run
+    printf("\n");
+    myRTC.stats().report(Serial);
+#endif
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Host check of MCP79412Calibrator (see src/MCP79412Calibrator.h).
+// Calibrates for a fine and then a coarse rate error, checks the trim
+// written and the history kept in EEPROM, then corrupts each bit of the
+// newest history record in turn, the coarse trim bit included, and
+// checks that the record is rejected.
+// Exits with a nonzero status if a check fails.
+
+#include <MCP79412Calibrator.h>
+#include <MCP7941xSim.h>
+#include <stdio.h>
+
+MCP7941xSim sim;
+MCP79412RTC rtc;
+MCP79412Calibrator cal(rtc);
+
+static int failures {0};
+
+static void check(const bool ok, const char* what)
+{
+    printf("%-48s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+// calibrate from two samples a day apart, for an RTC that gains
+// msPerDay, and return the history record written
+static MCP79412Calibrator::CAL_RECORD_t calibrate(const uint64_t refMs, const int32_t msPerDay)
+{
+    MCP79412Calibrator::CAL_RECORD_t rec {};
+    cal.reset();
+    cal.addSample(refMs, refMs);
+    cal.addSample(refMs + 86400000, refMs + 86400000 + msPerDay);
+    bool coarse;
+    int16_t trim = cal.optimalTrim(coarse);
+    printf("drift %+.1f ppm: trim %d%s", cal.drift(), trim, coarse ? " coarse" : "");
+    cal.apply();
+    printf(", RTC has %d%s\n", rtc.calibRead(), rtc.isCoarseTrim() ? " coarse" : "");
+    cal.historyRead(0, rec);
+    return rec;
+}
+
+int main()
+{
+    rtc.begin();
+    rtc.set(1735689600);
+    for (uint8_t i=0; i<MCP79412Calibrator::HISTORY_PAGES * MCP79412RTC::EEPROM_PAGE_SIZE; ++i) {
+        sim.setEeprom(MCP79412Calibrator::HISTORY_ADDR + i, 0xFF);
+    }
+
+    MCP79412Calibrator::CAL_RECORD_t fine = calibrate(1735689600000ULL, 1700);
+    check(!rtc.isCoarseTrim() && fine.trim == rtc.calibRead() && !(fine.flags & 0x80), "fine trim recorded");
+    MCP79412Calibrator::CAL_RECORD_t coarse = calibrate(1735776000000ULL, 700000);
+    check(rtc.isCoarseTrim() && coarse.trim == rtc.calibRead() && (coarse.flags & 0x80), "coarse trim recorded");
+    check(cal.historyCount() == 2, "two records in the history");
+
+    // the coarse record is in the second slot
+    const uint8_t addr = MCP79412Calibrator::HISTORY_ADDR + MCP79412RTC::EEPROM_PAGE_SIZE;
+    uint8_t rejected {0};
+    for (uint8_t bit=0; bit<8 * sizeof coarse; ++bit) {
+        uint8_t a = addr + bit / 8;
+        uint8_t b = sim.eeprom(a);
+        sim.setEeprom(a, b ^ 1 << bit % 8);
+        MCP79412Calibrator::CAL_RECORD_t rec;
+        if (cal.historyCount() == 1 && cal.historyRead(0, rec) && rec.time == fine.time) ++rejected;
+        else printf("bit %u of the record not detected\n", bit);
+        sim.setEeprom(a, b);
+    }
+    check(rejected == 8 * sizeof coarse, "each corrupted bit rejected");
+    sim.setEeprom(addr + 7, sim.eeprom(addr + 7) ^ 0x80);
+    check(cal.historyCount() == 1, "corrupted coarse trim bit rejected");
+
+    printf("%s\n", failures ? "FAILED" : "passed");
+    return failures != 0;
+}
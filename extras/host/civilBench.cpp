@@ -0,0 +1,140 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Host program that checks the loop-free time conversions (see
+// MCP7941xCivil.h) against the Time library's makeTime() and
+// breakTime() for every day from 1970 through 2105, and measures the
+// host CPU cycles (TSC) per call of each, and per get() on the
+// simulator with each. The loops in makeTime() and breakTime() depend
+// on the year, so times in 2025 are used. The ratios, more than the
+// host cycle counts, indicate the gain on a microcontroller.
+// See README.md in this directory for how to build it (add -O2).
+
+#include <MCP79412RTC.h>
+#include <MCP7941xSim.h>
+#include <stdio.h>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+MCP7941xSim sim;
+MCP79412RTC myRTC;
+volatile uint32_t sink;
+
+// host cycle counter, or nanoseconds where there is no TSC
+uint64_t cycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Print the cycles per call of two ways of doing something, and
+// their ratio.
+void report(const char* name, const double before, const double after)
+{
+    printf("%-28s %10.1f %10.1f %8.1fx\n", name, before, after, before / after);
+}
+
+// cycles per call of f(i), for i from 0 to n-1
+template <typename F>
+double measure(F f, const uint32_t n)
+{
+    uint64_t start = cycles();
+    for (uint32_t i=0; i<n; ++i) f(i);
+    return static_cast<double>(cycles() - start) / n;
+}
+
+int main()
+{
+    // check every day from 1970 through 2105, at a time that varies
+    uint32_t errors {0};
+    for (uint32_t d=0; d < 49710; ++d) {
+        time_t t = d * 86400UL + (d * 7919UL) % 86400;
+        tmElements_t a, b;
+        breakTime(t, a);
+        MCP7941xCivil::breakTime(t, b);
+        if (memcmp(&a, &b, sizeof a) != 0 || MCP7941xCivil::makeTime(a) != t || makeTime(a) != t) ++errors;
+        if (a.Year >= 30 && a.Year < 130) {     // the RTC's years, 2000-2099
+            uint8_t regs[tmNbrFields];
+            MCP7941xCivil::timeToRegs(t, regs);
+            if (MCP7941xCivil::regsToTime(regs) != t) ++errors;
+        }
+    }
+    for (uint16_t n=0; n<100; ++n) {
+        if (MCP7941xCivil::bcd2dec(MCP7941xCivil::dec2bcd(n)) != n) ++errors;
+    }
+    printf("checked 1970-2105: %u errors\n\n", static_cast<unsigned>(errors));
+
+    constexpr uint32_t n {1000000};
+    constexpr time_t base {1735689600};     // 2025-01-01
+    uint8_t regs[tmNbrFields];
+    MCP7941xCivil::timeToRegs(base, regs);
+    printf("%-28s %10s %10s %9s\n", "host cycles per call", "TimeLib", "civil", "ratio");
+
+    double before = measure([&](uint32_t i) {
+        regs[0] = MCP7941xCivil::dec2bcd(i % 60);
+        tmElements_t tm;
+        tm.Second = (regs[0] >> 4) * 10 + (regs[0] & 0x0F);
+        tm.Minute = (regs[1] >> 4) * 10 + (regs[1] & 0x0F);
+        tm.Hour = (regs[2] >> 4) * 10 + (regs[2] & 0x0F);
+        tm.Wday = regs[3];
+        tm.Day = (regs[4] >> 4) * 10 + (regs[4] & 0x0F);
+        tm.Month = (regs[5] >> 4) * 10 + (regs[5] & 0x0F);
+        tm.Year = y2kYearToTm((regs[6] >> 4) * 10 + (regs[6] & 0x0F));
+        sink = makeTime(tm);
+    }, n);
+    double after = measure([&](uint32_t i) {
+        regs[0] = MCP7941xCivil::dec2bcd(i % 60);
+        sink = MCP7941xCivil::regsToTime(regs);
+    }, n);
+    report("registers to time_t (get)", before, after);
+
+    before = measure([&](uint32_t i) {
+        tmElements_t tm;
+        breakTime(base + i * 97, tm);
+        regs[0] = tm.Second + 6 * (tm.Second / 10);
+        regs[1] = tm.Minute + 6 * (tm.Minute / 10);
+        regs[2] = tm.Hour + 6 * (tm.Hour / 10);
+        regs[3] = tm.Wday;
+        regs[4] = tm.Day + 6 * (tm.Day / 10);
+        regs[5] = tm.Month + 6 * (tm.Month / 10);
+        regs[6] = tmYearToY2k(tm.Year) + 6 * (tmYearToY2k(tm.Year) / 10);
+        sink = regs[0] + regs[4];
+    }, n);
+    after = measure([&](uint32_t i) {
+        MCP7941xCivil::timeToRegs(base + i * 97, regs);
+        sink = regs[0] + regs[4];
+    }, n);
+    report("time_t to registers (set)", before, after);
+
+    before = measure([&](uint32_t i) {
+        tmElements_t tm;
+        breakTime(base + i * 97, tm);
+        tm.Second = 0;
+        sink = makeTime(tm);
+    }, n);
+    after = measure([&](uint32_t i) {
+        sink = MCP7941xCivil::fromCivil(2025, 1 + i % 12, 1 + i % 28, 12, 0, 0);
+    }, n);
+    report("setAlarm(y, mon, d, h, m, s)", before, after);
+
+    myRTC.begin();
+    myRTC.set(base);
+    constexpr uint32_t nGets {100000};
+    before = measure([&](uint32_t) {
+        tmElements_t tm;
+        sink = myRTC.read(tm) ? makeTime(tm) : 0;      // get() as it was
+    }, nGets);
+    after = measure([&](uint32_t) {
+        sink = myRTC.get();
+    }, nGets);
+    report("get() on the simulator", before, after);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,112 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Host program that runs an MCP79412DutyPlanner against the MCP7941x
+// simulator for a day, sleeping until the MFP interrupt between
+// wakeups. It checks that each task runs within its deadline, and
+// compares the wakeups and bus cost measured on the simulated bus with
+// those predicted by budget(). See README.md in this directory for how
+// to build it.
+
+#include <MCP79412DutyPlanner.h>
+#include <MCP7941xSim.h>
+#include <stdio.h>
+
+MCP7941xSim sim;
+MCP79412RTC myRTC;
+MCP79412DutyPlanner planner(myRTC);
+
+constexpr uint8_t MFP_PIN {2};
+constexpr time_t START {1735689600 + 17};   // 00:00:17 1 Jan 2025
+
+struct TASK_SPEC_t {
+    const char* name;
+    uint32_t period;
+    uint32_t deadline;
+};
+const TASK_SPEC_t tasks[] {
+    {"sample sensor", 60, 20},
+    {"send radio", 300, 120},
+    {"log to EEPROM", 900, 600},
+    {"check battery", 3600, 1800},
+    {"sync time", 86400, 0},
+};
+constexpr uint8_t NTASKS {sizeof(tasks) / sizeof(tasks[0])};
+
+time_t release[NTASKS];     // the release each task is expected to run for
+uint32_t runs[NTASKS];
+uint32_t late;
+volatile bool woke;
+
+// the simulated time, without using the bus (the crystal has no error)
+time_t simTime()
+{
+    return START + hostMicros() / 1000000;
+}
+
+void runTask(const uint8_t id)
+{
+    time_t now = simTime();
+    while (release[id] + tasks[id].period <= now) release[id] += tasks[id].period;
+    if (now < release[id] || now > release[id] + tasks[id].deadline) {
+        ++late;
+        printf("%s at %ld, released %ld\n", tasks[id].name,
+            static_cast<long>(now - START), static_cast<long>(release[id] - START));
+    }
+    release[id] += tasks[id].period;
+    ++runs[id];
+}
+
+void mfpIsr()
+{
+    woke = true;
+}
+
+int main()
+{
+    myRTC.begin();
+    myRTC.set(START);
+    hostAdvance(0);
+    for (uint8_t i=0; i<NTASKS; ++i) {
+        release[i] = START - 17 + tasks[i].period;
+        planner.add(tasks[i].period, tasks[i].deadline, runTask, release[i]);
+    }
+    sim.connectMfp(MFP_PIN);
+    attachInterrupt(MFP_PIN, mfpIsr, FALLING);
+    planner.begin();
+
+    MCP79412DutyPlanner::BUDGET_t b {planner.budget(myRTC.get())};
+    printf("budget:   wakes %6u  task runs %6u  transfers %6u  bytes %6u  bus_us %8u\n",
+        static_cast<unsigned>(b.wakes), static_cast<unsigned>(b.taskRuns),
+        static_cast<unsigned>(b.transfers), static_cast<unsigned>(b.bytes),
+        static_cast<unsigned>(b.busMicros));
+    planner.report(Serial, myRTC.get(), 100000, 3000);
+
+    // sleep until the alarm, for a day
+    Wire.resetStats();
+    uint32_t wakes {0}, taskRuns {0};
+    uint64_t end = hostMicros() + 86400ULL * 1000000;
+    while (hostMicros() < end) {
+        hostAdvance(10000);
+        if (woke) {
+            woke = false;
+            ++wakes;
+            taskRuns += planner.wake();
+        }
+    }
+    const TwoWire::Stats& s = Wire.stats();
+    printf("measured: wakes %6u  task runs %6u  transfers %6u  bytes %6u  bus_us %8llu\n",
+        static_cast<unsigned>(wakes), static_cast<unsigned>(taskRuns),
+        static_cast<unsigned>(s.writeTransfers + s.readTransfers),
+        static_cast<unsigned>(s.bytesWritten + s.bytesRead),
+        static_cast<unsigned long long>(s.busMicros));
+    for (uint8_t i=0; i<NTASKS; ++i) {
+        printf("%-14s every %5us within %4us: %4u runs\n", tasks[i].name,
+            static_cast<unsigned>(tasks[i].period), static_cast<unsigned>(tasks[i].deadline),
+            static_cast<unsigned>(runs[i]));
+    }
+    printf("%u late\n", static_cast<unsigned>(late));
+    return late != 0;
+}
@@ -0,0 +1,104 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Host program that runs the library on the Linux i2c-dev transport
+// (see MCP7941xLinuxI2C.h), against a fake i2c-dev device (see
+// HostI2CDev.h) on the MCP7941x simulator. It reports the ioctl() calls
+// and I2C transfers that each function costs, and checks the results
+// against MCP79412RTC on the Wire library, and that EEPROM writes sleep
+// through the write cycle rather than polling the device back to back
+// (a page write costs 4 ioctl() calls, not about 45).
+// See README.md in this directory for how to build it.
+
+#include <MCP79412RTC.h>
+#include <MCP7941xLinuxI2C.h>
+#include <MCP7941xSim.h>
+#include <HostI2CDev.h>
+#include <stdio.h>
+
+MCP7941xSim sim;
+HostI2CDev i2cDev;
+MCP7941x<LinuxI2CTransport> linuxRTC {i2cDev.transport()};
+MCP79412RTC wireRTC;
+uint32_t errors {0};
+
+void check(const bool ok, const char* msg)
+{
+    if (!ok) {
+        ++errors;
+        printf("FAIL: %s\n", msg);
+    }
+}
+
+// Print one row of the report: ioctl() calls and bus statistics since
+// the last call, then reset them. Returns the ioctl() calls.
+uint32_t report(const char* name)
+{
+    const TwoWire::Stats& s = Wire.stats();
+    uint32_t calls {i2cDev.calls()};
+    printf("%-28s %8u %6u %8u %6u\n", name, static_cast<unsigned>(i2cDev.calls()),
+        static_cast<unsigned>(s.starts), static_cast<unsigned>(s.repeatedStarts),
+        static_cast<unsigned>(s.stops));
+    i2cDev.resetCalls();
+    Wire.resetStats();
+    return calls;
+}
+
+int main()
+{
+    uint8_t buf[128], ref[128];
+    tmElements_t tm;
+    time_t powerDown, powerUp;
+
+    linuxRTC.begin();
+    printf("%-28s %8s %6s %8s %6s\n", "function", "ioctls", "starts", "rep_strt", "stops");
+    i2cDev.resetCalls();
+    Wire.resetStats();
+
+    check(linuxRTC.set(1735689600) == 0, "set()");   report("set(time_t)");
+    time_t t = linuxRTC.get();                          report("get()");
+    check(t == wireRTC.get(), "get()");
+    Wire.resetStats();
+    check(linuxRTC.read(tm), "read()");                 report("read(tm)");
+    linuxRTC.isRunning();                               report("isRunning()");
+    linuxRTC.readRTC(MCP79412RTC::CONTROL);             report("readRTC(addr)");
+    linuxRTC.writeRTC(MCP79412RTC::CONTROL, 0x80);      report("writeRTC(addr, value)");
+    for (uint8_t i=0; i<64; ++i) buf[i] = i * 3;
+    linuxRTC.sramWrite(0, buf, 64);                     report("sramWrite(0, buf, 64)");
+    memset(buf, 0, sizeof buf);
+    linuxRTC.sramRead(0, buf, 64);                      report("sramRead(0, buf, 64)");
+    wireRTC.sramRead(0, ref, 64);
+    check(memcmp(buf, ref, 64) == 0, "sramRead()");
+    for (uint8_t i=0; i<64; ++i) check(buf[i] == static_cast<uint8_t>(i * 3), "sramWrite()");
+    Wire.resetStats();
+    linuxRTC.eepromWrite(0, buf, 8);
+    check(report("eepromWrite(0, buf, 8)") <= 6, "eepromWrite() polling");
+    for (uint8_t i=0; i<128; ++i) buf[i] = 255 - i;
+    linuxRTC.eepromWriteBulk(0, buf, 128);
+    check(report("eepromWriteBulk(0, buf, 128)") <= 16 * 4, "eepromWriteBulk() polling");
+    memset(buf, 0, sizeof buf);
+    linuxRTC.eepromReadBulk(0, buf, 128);               report("eepromReadBulk(0, buf, 128)");
+    wireRTC.eepromReadBulk(0, ref, 128);
+    check(memcmp(buf, ref, 128) == 0, "eepromReadBulk()");
+    for (uint8_t i=0; i<128; ++i) check(buf[i] == 255 - i, "eepromWriteBulk()");
+    Wire.resetStats();
+    linuxRTC.idRead(buf);                               report("idRead(buf)");
+    linuxRTC.calibWrite(-5);                            report("calibWrite(-5)");
+    check(linuxRTC.calibRead() == -5, "calibRead()");   report("calibRead()");
+    linuxRTC.setAlarm(MCP79412RTC::ALARM_0, t + 60);    report("setAlarm(alarm, time_t)");
+    linuxRTC.enableAlarm(MCP79412RTC::ALARM_0, MCP79412RTC::ALM_MATCH_DATETIME);
+                                                        report("enableAlarm()");
+    linuxRTC.alarm(MCP79412RTC::ALARM_0);               report("alarm(ALARM_0)");
+    linuxRTC.powerFail(&powerDown, &powerUp);           report("powerFail()");
+
+    // no device at the address: the transport reports a NACK
+    linuxRTC.transport().beginTransmission(0x50);
+    linuxRTC.transport().write(0);
+    check(linuxRTC.transport().endTransmission() == 2, "NACK status");
+    check(linuxRTC.transport().lastErrno() == ENXIO, "NACK errno");
+
+    printf("%u errors\n", static_cast<unsigned>(errors));
+    return errors ? 1 : 0;
+}
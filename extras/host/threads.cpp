@@ -0,0 +1,130 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Host program that uses one MCP79412RTC from several std::threads at
+// once, with a bus lock (see MCP79412BusLock.h), against the MCP7941x
+// simulator. First several threads call get() together, to show how
+// many reads they share; then threads doing different things at once
+// check that each library function is atomic.
+// See README.md in this directory for how to build it (add -pthread).
+
+#include <MCP79412RTC.h>
+#include <MCP7941xSim.h>
+#include <HostBusLock.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+
+// Simulated transfers take no real time, so threads would hardly ever
+// contend for the bus. This lock holds the bus for a little real time
+// per library function, as the transfers would on hardware.
+class SlowBusLock : public HostBusLock
+{
+    public:
+        void lock()
+        {
+            HostBusLock::lock();
+            if (m_depth++ == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        void unlock()
+        {
+            --m_depth;
+            HostBusLock::unlock();
+        }
+
+    private:
+        uint8_t m_depth {0};    // nesting, changed only while locked
+};
+
+MCP7941xSim sim;
+MCP79412RTC myRTC;
+SlowBusLock busLock;
+std::atomic<uint32_t> errors {0};
+
+void fail(const char* msg)
+{
+    ++errors;
+    fprintf(stderr, "FAIL: %s\n", msg);
+}
+
+// get() many times; the times must never go backwards.
+void reader(const uint32_t n)
+{
+    time_t last {0};
+    for (uint32_t i=0; i<n; ++i) {
+        time_t t = myRTC.get();
+        if (t == 0 || t < last) fail("get() returned a bad time");
+        last = t;
+    }
+}
+
+// Fill this thread's own 16 bytes of SRAM with one value, read them
+// back, and check that they were not mixed with another thread's.
+void sramUser(const uint8_t addr, const uint32_t n)
+{
+    uint8_t buf[16];
+    for (uint32_t i=0; i<n; ++i) {
+        memset(buf, static_cast<uint8_t>(i + addr), sizeof(buf));
+        myRTC.sramWrite(addr, buf, sizeof(buf));
+        myRTC.sramRead(addr, buf, sizeof(buf));
+        for (uint8_t b : buf) {
+            if (b != static_cast<uint8_t>(i + addr)) {
+                fail("SRAM contents mixed");
+                break;
+            }
+        }
+    }
+}
+
+// Set, enable and poll an alarm, a multi-transaction read-modify-write
+// of registers that the other threads also change.
+void alarmUser(const uint32_t n)
+{
+    for (uint32_t i=0; i<n; ++i) {
+        myRTC.setAlarm(MCP79412RTC::ALARM_0, myRTC.get() + 2);
+        myRTC.enableAlarm(MCP79412RTC::ALARM_0, MCP79412RTC::ALM_MATCH_SECONDS);
+        myRTC.alarm(MCP79412RTC::ALARM_0);
+        myRTC.squareWave(i & 1 ? MCP79412RTC::SQWAVE_1_HZ : MCP79412RTC::SQWAVE_NONE);
+    }
+}
+
+// Set the time: two writes, with the oscillator stopped in between.
+void setter(const uint32_t n)
+{
+    for (uint32_t i=0; i<n; ++i) {
+        myRTC.set(myRTC.get());
+        if (!myRTC.isRunning()) fail("oscillator left stopped");
+    }
+}
+
+int main()
+{
+    myRTC.setBusLock(&busLock);
+    myRTC.begin();
+    myRTC.set(1735689600);
+
+    constexpr uint32_t nGets {200};
+    constexpr uint8_t nReaders {8};
+    sim.resetCounters();
+    std::vector<std::thread> threads;
+    for (uint8_t i=0; i<nReaders; ++i) threads.emplace_back(reader, nGets);
+    for (auto& t : threads) t.join();
+    printf("%u threads called get() %u times; the RTC was read %u times\n",
+        nReaders, nReaders * nGets, static_cast<unsigned>(sim.rtcCounters().reads));
+
+    threads.clear();
+    threads.emplace_back(reader, 200);
+    threads.emplace_back(reader, 200);
+    threads.emplace_back(sramUser, 0, 200);
+    threads.emplace_back(sramUser, 16, 200);
+    threads.emplace_back(sramUser, 32, 200);
+    threads.emplace_back(alarmUser, 50);
+    threads.emplace_back(setter, 50);
+    for (auto& t : threads) t.join();
+    printf("mixed workload: %u errors\n", static_cast<unsigned>(errors));
+    return errors ? 1 : 0;
+}
@@ -13,6 +13,10 @@
 #include <TimeLib.h>    // https://github.com/PaulStoffregen/Time
 #include <Wire.h>
 
+#ifdef MCP79412_STATS
+class MCP79412Stats;
+#endif
+
 class GenericRTC
 {
     public:
@@ -25,6 +29,9 @@ class GenericRTC
         virtual uint8_t readRTC(const uint8_t addr, uint8_t* values, const uint8_t nBytes) = 0;
         virtual uint8_t readRTC(const uint8_t addr) = 0;
         virtual int16_t temperature() {return 0;};
+#ifdef MCP79412_STATS
+        virtual MCP79412Stats* busStats() {return nullptr;}    // bus statistics, if kept
+#endif
 
     protected:
         TwoWire& wire;      // reference to Wire, Wire1, etc.
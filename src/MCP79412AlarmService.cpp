@@ -0,0 +1,66 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Interrupt-driven alarm service, see MCP79412AlarmService.h.
+
+#include <MCP79412AlarmService.h>
+
+MCP79412AlarmService* MCP79412AlarmService::s_instance {nullptr};
+
+// Attach the interrupt for the MFP, which must be connected to the
+// given interrupt-capable pin. Reads ALMPOL to find the MFP's active
+// edge, so call begin() again after changing alarmPolarity(). An alarm
+// that is already asserting the MFP is pending at once.
+void MCP79412AlarmService::begin(const uint8_t pin)
+{
+    end();
+    m_pin = pin;
+    m_pol = m_rtc.alarmPolarityBit(MCP79412RTC::ALARM_0);
+    s_instance = this;
+    pinMode(pin, INPUT_PULLUP);     // the MFP is open drain
+    attachInterrupt(digitalPinToInterrupt(pin), isr, m_pol ? RISING : FALLING);
+    if (asserted()) m_pending = true;
+}
+
+// Detach the interrupt.
+void MCP79412AlarmService::end()
+{
+    if (s_instance != this) return;
+    detachInterrupt(digitalPinToInterrupt(m_pin));
+    s_instance = nullptr;
+    m_pending = false;
+}
+
+// If an alarm is pending, read both alarms' flags with one burst read
+// and clear the ones that are set with one write, see
+// MCP79412RTC::clearAlarmFlags(). Returns the alarms that fired
+// (ALARM0, ALARM1 or both), or zero, without using the bus, if none is
+// pending. If the read fails, the alarm stays pending.
+uint8_t MCP79412AlarmService::service()
+{
+    if (!m_pending) return 0;
+    m_pending = false;      // an edge from here on is pending again
+
+    MCP79412BusGuard guard(m_rtc.getBusLock());
+    MCP79412RTC::SNAPSHOT_t snap;
+    uint8_t* r = snap.regs + MCP79412RTC::ALM0WKDAY;
+    if (m_rtc.readRTC(MCP79412RTC::ALM0WKDAY, r, MCP79412RTC::ALM1WKDAY - MCP79412RTC::ALM0WKDAY + 1) != 0) {
+        m_pending = true;
+        return 0;
+    }
+    snap.alarm0 = snap.regs[MCP79412RTC::ALM0WKDAY] & _BV(MCP79412RTC::ALMxIF);
+    snap.alarm1 = snap.regs[MCP79412RTC::ALM1WKDAY] & _BV(MCP79412RTC::ALMxIF);
+    uint8_t fired = (snap.alarm0 ? ALARM0 : 0) | (snap.alarm1 ? ALARM1 : 0);
+
+    // only the alarm registers read are written
+    m_rtc.clearAlarmFlags(snap, snap.alarm0, snap.alarm1);
+    if (asserted()) m_pending = true;
+    return fired;
+}
+
+void MCP79412_ISR_ATTR MCP79412AlarmService::isr()
+{
+    if (s_instance) s_instance->m_pending = true;
+}
@@ -0,0 +1,52 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Interrupt-driven alarm service. The MFP is connected to an interrupt
+// pin and the ISR only notes that an alarm is pending. service(),
+// called from loop(), then reads ALM0WKDAY through ALM1WKDAY in one
+// burst, reports which alarms fired and clears their flags with one
+// write. While no alarm is pending, service() does not use the bus,
+// unlike polling with alarm().
+//
+// With both alarms enabled, the MFP follows the ALMPOL semantics (see
+// MCP79412RTC::alarmPolarity()): with ALMPOL high the MFP goes high
+// when EITHER alarm fires; with ALMPOL low (the default) it goes low
+// only when BOTH have fired, so the first alarm is reported only
+// together with the second. The interrupt is attached to the MFP's
+// active edge for the polarity read by begin(). If a flag that was not
+// seen by the burst read keeps the MFP asserted after the write, e.g.
+// the other alarm fired in between, the alarm stays pending. Only one
+// instance can be active.
+
+#ifndef MCP79412_ALARMSERVICE_H_INCLUDED
+#define MCP79412_ALARMSERVICE_H_INCLUDED
+
+#include <MCP79412RTC.h>
+
+class MCP79412AlarmService
+{
+    public:
+        // bits returned by service()
+        static constexpr uint8_t
+            ALARM0 {_BV(MCP79412RTC::ALARM_0)},
+            ALARM1 {_BV(MCP79412RTC::ALARM_1)};
+
+        MCP79412AlarmService(MCP79412RTC& rtc) : m_rtc{rtc} {}
+        void begin(const uint8_t pin);
+        void end();
+        bool pending() {return m_pending;}
+        uint8_t service();
+
+    private:
+        MCP79412RTC& m_rtc;
+        uint8_t m_pin;
+        bool m_pol;                     // ALMPOL, the MFP's active level
+        volatile bool m_pending {false};
+
+        static MCP79412AlarmService* s_instance;
+        static void isr();
+        bool asserted() {return (digitalRead(m_pin) == HIGH) == m_pol;}
+};
+#endif
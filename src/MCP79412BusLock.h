@@ -0,0 +1,88 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Bus locking for multitasking systems.
+// Many MCP79412RTC functions take more than one I2C transaction, e.g.
+// write() (two writes), powerFail() (a read and a write) and
+// enableAlarm() (reads and writes). If two tasks use the same RTC at
+// once, their transactions can interleave and corrupt the RTC's state.
+// An MCP79412BusLock given to MCP79412RTC::setBusLock() is held for the
+// whole of each library function, so each function is atomic with
+// respect to the others. The lock must be recursive, i.e. a task that
+// holds it can lock it again, since library functions call each other.
+// The same lock can be given to several RTCs, and used by other code,
+// to serialize everything on a shared bus.
+//
+// The lock also provides a short critical section, enterCritical() and
+// exitCritical(), for the little state that get() reads before taking
+// the lock. The default disables interrupts, which is enough on a
+// single core; a lock for a multicore system must override them.
+//
+// MCP79412RtosLock is a lock for FreeRTOS (e.g. ESP32), using a
+// recursive mutex. For other systems, derive a class from
+// MCP79412BusLock.
+
+#ifndef MCP79412_BUS_LOCK_H_INCLUDED
+#define MCP79412_BUS_LOCK_H_INCLUDED
+
+#include <Arduino.h>
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#define MCP79412_HAS_RTOS_LOCK
+#elif defined(INC_FREERTOS_H)       // e.g. Arduino_FreeRTOS, included first
+#include <semphr.h>
+#define MCP79412_HAS_RTOS_LOCK
+#endif
+
+class MCP79412BusLock
+{
+    public:
+        virtual ~MCP79412BusLock() {}
+        virtual void lock() = 0;
+        virtual void unlock() = 0;
+        virtual void enterCritical() {noInterrupts();}
+        virtual void exitCritical() {interrupts();}
+};
+
+// Holds a lock (if any) for the life of the guard.
+class MCP79412BusGuard
+{
+    public:
+        MCP79412BusGuard(MCP79412BusLock* lock) : m_lock{lock} {if (m_lock) m_lock->lock();}
+        ~MCP79412BusGuard() {if (m_lock) m_lock->unlock();}
+        MCP79412BusGuard(const MCP79412BusGuard&) = delete;
+        MCP79412BusGuard& operator=(const MCP79412BusGuard&) = delete;
+
+    private:
+        MCP79412BusLock* m_lock;
+};
+
+#ifdef MCP79412_HAS_RTOS_LOCK
+class MCP79412RtosLock : public MCP79412BusLock
+{
+    public:
+        MCP79412RtosLock() : m_mutex{xSemaphoreCreateRecursiveMutex()} {}
+        ~MCP79412RtosLock() {vSemaphoreDelete(m_mutex);}
+        MCP79412RtosLock(const MCP79412RtosLock&) = delete;
+        MCP79412RtosLock& operator=(const MCP79412RtosLock&) = delete;
+        void lock() {xSemaphoreTakeRecursive(m_mutex, portMAX_DELAY);}
+        void unlock() {xSemaphoreGiveRecursive(m_mutex);}
+#if defined(ESP32)
+        void enterCritical() {portENTER_CRITICAL(&m_mux);}
+        void exitCritical() {portEXIT_CRITICAL(&m_mux);}
+#else
+        void enterCritical() {taskENTER_CRITICAL();}
+        void exitCritical() {taskEXIT_CRITICAL();}
+#endif
+
+    private:
+        SemaphoreHandle_t m_mutex;
+#if defined(ESP32)
+        portMUX_TYPE m_mux = portMUX_INITIALIZER_UNLOCKED;  // spinlock, for both cores
+#endif
+};
+#endif
+#endif
@@ -0,0 +1,214 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Cached, millis()-extrapolated time, see MCP79412CachedClock.h.
+
+#include <MCP79412CachedClock.h>
+
+// Lock to the RTC, waiting (up to about two seconds) for the seconds to
+// roll over. Call again after setting the RTC. Returns false if the
+// RTC did not respond or is not running; get() then reads the RTC,
+// and poll() tries to lock again later.
+bool MCP79412CachedClock::begin()
+{
+    m_drift = 0;
+    m_interval = 0;
+    m_anchored = false;
+    m_retry = 0;
+    lock();
+    while (m_state == LOCKING || m_coarse) {
+        poll();
+        delay(1);
+    }
+    return isLocked();
+}
+
+// Resynchronize with the RTC when it is time to. Call frequently, e.g.
+// from loop(). Between resyncs this does nothing; in the few
+// milliseconds around a predicted rollover, each call reads the RTC's
+// seconds register at most once per millisecond. While unlocked, it
+// starts to lock again when the retry time comes.
+void MCP79412CachedClock::poll()
+{
+    uint32_t ms = millis();
+    switch (m_state) {
+        case UNLOCKED:
+            if (m_retry && static_cast<int32_t>(ms - m_msWindow) >= 0) lock();
+            break;
+        case LOCKING:
+            lockPoll(ms);
+            break;
+        case RESYNC_WAIT:
+            if (static_cast<int32_t>(ms - m_msWindow) < 0) break;
+            m_state = RESYNC;
+            m_firstRead = true;
+            // fall through
+        case RESYNC:
+            resyncPoll(ms);
+            break;
+    }
+}
+
+// Return the current time, extrapolated from the last resync.
+// This does not use the I2C bus unless the clock has never locked.
+time_t MCP79412CachedClock::get()
+{
+    if (!m_anchored) return m_rtc.get();
+    return m_tAnchor + mcuToRtc(millis() - m_msAnchor) / 1000;
+}
+
+// Start looking for a seconds rollover, keeping the current drift
+// estimate. The clock continues to extrapolate from the last anchor
+// while locking.
+void MCP79412CachedClock::lock()
+{
+    m_state = LOCKING;
+    m_firstRead = true;
+    m_coarse = false;
+    m_msWindow = millis();          // start of the lock attempt
+    m_msLastRead = m_msWindow - guard();    // read at once
+}
+
+// One step of locking: read the time, then the seconds register every
+// guard interval until it changes. That locates the rollover well
+// enough to find the next one exactly, as a resync. If there is no
+// rollover in time, try again after a wait that doubles each time, up
+// to MAX_INTERVAL.
+void MCP79412CachedClock::lockPoll(const uint32_t ms)
+{
+    if (ms - m_msWindow > LOCK_TIMEOUT_MS) {
+        m_retry = m_retry ? 2 * m_retry : MIN_INTERVAL;
+        if (m_retry > MAX_INTERVAL) m_retry = MAX_INTERVAL;
+        m_msWindow = ms + m_retry * 1000;
+        m_state = UNLOCKED;
+        return;
+    }
+    if (ms - m_msLastRead < guard()) return;
+    m_msLastRead = ms;
+
+    uint8_t sec;
+    if (m_firstRead) {
+        time_t t = m_rtc.get();
+        ++m_readCount;
+        if (t == 0) return;         // I2C error or RTC not set
+        m_target = t + 1;
+        sec = t % 60;
+        m_firstRead = false;
+    }
+    else {
+        uint8_t s = m_rtc.readRTC(MCP79412RTC::RTCSEC) & 0x7F;
+        ++m_readCount;
+        sec = (s >> 4) * 10 + (s & 0x0F);
+        if (sec != m_lastSec) {
+            if (sec == m_target % 60 && ms - m_msPrevRead <= 2 * guard()) {
+                anchor(m_target, m_msPrevRead + (ms - m_msPrevRead) / 2);
+                // after a fresh lock the drift is unknown; assume it may
+                // be as much as 1% so the first resync can't miss.
+                if (m_interval == 0) m_interval = m_maxError / 20;
+                if (m_interval < MIN_INTERVAL) m_interval = MIN_INTERVAL;
+                m_coarse = true;
+                m_retry = 0;
+                schedule(1);
+                return;
+            }
+            m_firstRead = true;     // polled too slowly, try again
+        }
+    }
+    m_lastSec = sec;
+    m_msPrevRead = ms;
+}
+
+// One step of a resync: read the seconds register until it changes to
+// the target second, measure the rollover and update the drift estimate
+// and the resync interval. If the rollover is not where it is expected
+// to be, lock again.
+void MCP79412CachedClock::resyncPoll(const uint32_t ms)
+{
+    if (ms == m_msLastRead) return;
+    m_msLastRead = ms;
+
+    uint8_t s = m_rtc.readRTC(MCP79412RTC::RTCSEC) & 0x7F;
+    ++m_readCount;
+    uint8_t sec = (s >> 4) * 10 + (s & 0x0F);
+    uint8_t expected = m_target % 60;
+
+    if (m_firstRead) {
+        m_firstRead = false;
+        if (sec != (expected + 59) % 60) {      // rollover already happened
+            m_interval /= 2;
+            lock();
+            return;
+        }
+    }
+    else if (sec != m_lastSec) {
+        if (sec != expected) {
+            m_interval /= 2;
+            lock();
+            return;
+        }
+        uint32_t msEdge = m_msPrevRead + (ms - m_msPrevRead) / 2;
+        if (m_coarse) {             // finishing a lock
+            m_coarse = false;
+            anchor(m_target, msEdge);
+            schedule(m_interval);
+            return;
+        }
+        uint32_t rtcMs = static_cast<uint32_t>(m_target - m_tAnchor) * 1000;
+        uint32_t mcuMs = msEdge - m_msAnchor;
+        int32_t err = static_cast<int32_t>(msEdge - (m_msWindow + guard()));
+        m_drift = (static_cast<int64_t>(mcuMs) - rtcMs) * 1000000000 / rtcMs;
+
+        // the prediction error is what the old drift estimate let
+        // accumulate over the interval; scale the interval so the error
+        // would have been half the bound, growing it at most 8 times.
+        uint32_t absErr = (err < 0 ? -err : err) + 2;
+        uint32_t next = m_interval * (m_maxError / 2) / absErr;
+        if (next > m_interval * 8) next = m_interval * 8;
+        if (next > MAX_INTERVAL) next = MAX_INTERVAL;
+        if (next < MIN_INTERVAL) next = MIN_INTERVAL;
+        m_interval = next;
+        ++m_syncCount;
+        anchor(m_target, msEdge);
+        schedule(m_interval);
+        return;
+    }
+    else if (static_cast<int32_t>(ms - m_msWindowEnd) > 0) {  // no rollover
+        m_interval /= 2;
+        lock();
+        return;
+    }
+    m_lastSec = sec;
+    m_msPrevRead = ms;
+}
+
+// Record that RTC second t began at millis() ms.
+void MCP79412CachedClock::anchor(const time_t t, const uint32_t ms)
+{
+    m_tAnchor = t;
+    m_msAnchor = ms;
+    m_anchored = true;
+}
+
+// Set the window for the next resync, around the predicted start of
+// the second the given number of seconds after the anchor.
+void MCP79412CachedClock::schedule(const uint32_t seconds)
+{
+    m_target = m_tAnchor + seconds;
+    uint32_t msEdge = m_msAnchor + rtcToMcu(seconds * 1000);
+    m_msWindow = msEdge - guard();
+    m_msWindowEnd = msEdge + guard();
+    m_state = RESYNC_WAIT;
+}
+
+// Convert an RTC interval to MCU milliseconds, and vice versa.
+uint32_t MCP79412CachedClock::rtcToMcu(const uint32_t rtcMs)
+{
+    return static_cast<int64_t>(rtcMs) * (1000000000 + m_drift) / 1000000000;
+}
+
+uint32_t MCP79412CachedClock::mcuToRtc(const uint32_t mcuMs)
+{
+    return static_cast<int64_t>(mcuMs) * 1000000000 / (1000000000 + m_drift);
+}
@@ -0,0 +1,74 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// A clock that reads the RTC rarely and extrapolates with millis().
+// The clock locks to the RTC's seconds rollover, then learns the rate
+// of the MCU's clock relative to the RTC each time it resynchronizes.
+// Resynchronization is done from poll(), without blocking, by reading
+// the seconds register a few times around the predicted rollover. The
+// interval between resyncs is adjusted to keep the error within the
+// given bound: it grows as the drift estimate improves and shrinks if
+// the prediction error grows. get() never touches the I2C bus once
+// the clock has locked. If locking fails, poll() tries again later,
+// doubling the wait each time up to MAX_INTERVAL.
+
+#ifndef MCP79412_CACHED_CLOCK_H_INCLUDED
+#define MCP79412_CACHED_CLOCK_H_INCLUDED
+
+#include <MCP79412RTC.h>
+
+class MCP79412CachedClock
+{
+    public:
+        static constexpr uint32_t
+            MIN_INTERVAL {1},           // seconds between resyncs, minimum
+            MAX_INTERVAL {86400};       // and maximum
+        static constexpr uint16_t
+            LOCK_TIMEOUT_MS {1100};     // max time to wait for a seconds rollover
+
+        MCP79412CachedClock(MCP79412RTC& rtc, const uint16_t maxErrorMs=50)
+            : m_rtc{rtc}, m_maxError{maxErrorMs} {}
+        bool begin();
+        void poll();
+        time_t get();
+        bool isLocked() {return !m_coarse && (m_state == RESYNC_WAIT || m_state == RESYNC);}
+        int32_t drift() {return m_drift;}
+        uint32_t syncInterval() {return m_interval;}
+        uint32_t syncCount() {return m_syncCount;}
+        uint32_t readCount() {return m_readCount;}
+
+    private:
+        enum state_t {UNLOCKED, LOCKING, RESYNC_WAIT, RESYNC};
+
+        MCP79412RTC& m_rtc;
+        uint16_t m_maxError;        // error bound, ms
+        state_t m_state {UNLOCKED};
+        bool m_anchored {false};    // the anchor is set, the clock has locked
+        time_t m_tAnchor;           // an RTC second
+        uint32_t m_msAnchor;        // millis() when that second began
+        int32_t m_drift {0};        // MCU clock rate relative to RTC, ppb
+        uint32_t m_interval;        // seconds between resyncs
+        time_t m_target;            // second whose start is being looked for
+        uint32_t m_msWindow;        // resync window: start (or lock attempt start, or retry time)
+        uint32_t m_msWindowEnd;     // and end
+        uint32_t m_msLastRead;      // time of the last read, at most one per ms
+        uint32_t m_msPrevRead;      // time of the previous read of the seconds
+        uint8_t m_lastSec;          // and its value
+        bool m_firstRead;           // no reads yet in the current lock or window
+        bool m_coarse {false};      // locking, the anchor is only approximate
+        uint32_t m_retry {0};       // seconds to wait before locking again, zero if not to
+        uint32_t m_syncCount {0};   // number of resyncs
+        uint32_t m_readCount {0};   // number of RTC reads
+
+        void lock();
+        void lockPoll(const uint32_t ms);
+        void resyncPoll(const uint32_t ms);
+        void anchor(const time_t t, const uint32_t ms);
+        void schedule(const uint32_t seconds);
+        uint32_t rtcToMcu(const uint32_t rtcMs);
+        uint32_t mcuToRtc(const uint32_t mcuMs);
+        uint16_t guard() {return m_maxError + 2;}
+};
+#endif
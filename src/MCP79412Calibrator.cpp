@@ -0,0 +1,173 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Oscillator calibration, see MCP79412Calibrator.h.
+
+#include <MCP79412Calibrator.h>
+#include <MCP79412EepromLog.h>
+
+static_assert(MCP79412EepromLog::DEFAULT_PAGES * MCP79412EepromLog::PAGE_SIZE <= MCP79412Calibrator::HISTORY_ADDR,
+    "the default EEPROM log and calibration history overlap");
+
+// Add a sample: a reference time and the RTC's time at the same moment,
+// both in milliseconds (e.g. from MCP79412SubSecond::nowMillis()).
+// The fit is updated incrementally (Welford's method), which keeps the
+// precision of float arithmetic even over long spans.
+void MCP79412Calibrator::addSample(const uint64_t refMs, const uint64_t rtcMs)
+{
+    int64_t off = static_cast<int64_t>(rtcMs - refMs);
+    if (m_n == 0) {
+        m_ref0 = refMs;
+        m_off0 = off;
+        m_mx = m_my = m_cxx = m_cxy = 0;
+    }
+    float x = (refMs - m_ref0) / 1000.0;
+    float y = off - m_off0;
+    ++m_n;
+    float dx = x - m_mx;
+    m_mx += dx / m_n;
+    m_my += (y - m_my) / m_n;
+    m_cxx += dx * (x - m_mx);
+    m_cxy += dx * (y - m_my);
+    m_span = x;
+    m_lastRef = refMs / 1000;
+}
+
+// Add a sample from a reference time in whole seconds, reading the RTC
+// now. Call it just after the reference second begins. With one second
+// resolution, samples should span days to resolve a few ppm.
+// Returns false, and adds no sample, if the RTC could not be read.
+bool MCP79412Calibrator::addSample(const time_t ref)
+{
+    time_t t = m_rtc.get();
+    if (t == 0) return false;
+    addSample(static_cast<uint64_t>(ref) * 1000, static_cast<uint64_t>(t) * 1000);
+    return true;
+}
+
+// The RTC's rate error in ppm, as currently trimmed, relative to the
+// reference. Positive if the RTC runs fast. Zero with fewer than two
+// samples.
+float MCP79412Calibrator::drift()
+{
+    if (m_n < 2 || m_cxx <= 0) return 0;
+    return m_cxy / m_cxx * 1000;     // ms per s to ppm
+}
+
+// Calculate the calibration value and trim mode that would cancel the
+// measured drift, allowing for the trim currently in effect. Coarse
+// trim is used only if it leaves a smaller error than fine trim.
+int16_t MCP79412Calibrator::optimalTrim(bool& coarse)
+{
+    float step {FINE_PPM};
+    if (m_rtc.isCoarseTrim()) step = COARSE_PPM;
+    float xtal = drift() + m_rtc.calibRead() * step;   // untrimmed error
+    int16_t fine = roundTrim(xtal / FINE_PPM);
+    int16_t crs = roundTrim(xtal / COARSE_PPM);
+    coarse = fabs(xtal - crs * COARSE_PPM) < fabs(xtal - fine * FINE_PPM);
+    return coarse ? crs : fine;
+}
+
+// Round a calibration value to the nearest integer in the valid range.
+int16_t MCP79412Calibrator::roundTrim(const float v)
+{
+    if (v > 127) return 127;
+    if (v < -127) return -127;
+    return static_cast<int16_t>(v < 0 ? v - 0.5 : v + 0.5);
+}
+
+// Apply the optimal calibration, record it in the history and start a
+// new fit (the rate has changed). Returns false, and does nothing, with
+// fewer than two samples.
+bool MCP79412Calibrator::apply()
+{
+    if (m_n < 2) return false;
+    bool coarse;
+    int16_t trim = optimalTrim(coarse);
+    float d = drift() * 10;
+    if (d > 32767) d = 32767;
+    if (d < -32767) d = -32767;
+
+    m_rtc.calibWrite(trim);
+    if (coarse != m_rtc.isCoarseTrim()) m_rtc.coarseTrim(coarse);
+
+    if (m_histPages > 0) {
+        // write over the slot after the newest record
+        uint8_t slot {0};
+        uint32_t newest {0};
+        CAL_RECORD_t rec;
+        for (uint8_t i=0; i<m_histPages; ++i) {
+            if (historySlot(i, rec) && rec.time >= newest) {
+                newest = rec.time;
+                slot = (i + 1) % m_histPages;
+            }
+        }
+        rec.time = m_lastRef;
+        rec.drift = static_cast<int16_t>(d < 0 ? d - 0.5 : d + 0.5);
+        rec.trim = trim;
+        rec.flags = coarse ? 0x80 : 0;
+        rec.flags |= check(rec);
+        m_rtc.eepromWrite(m_histAddr + slot * MCP79412RTC::EEPROM_PAGE_SIZE,
+            reinterpret_cast<uint8_t*>(&rec), sizeof(rec));
+    }
+    m_n = 0;
+    return true;
+}
+
+// Number of valid records in the history.
+uint8_t MCP79412Calibrator::historyCount()
+{
+    uint8_t n {0};
+    CAL_RECORD_t rec;
+    for (uint8_t i=0; i<m_histPages; ++i) {
+        if (historySlot(i, rec)) ++n;
+    }
+    return n;
+}
+
+// Read a record from the history, index 0 being the newest.
+// Returns false if there is no such record.
+bool MCP79412Calibrator::historyRead(const uint8_t index, CAL_RECORD_t& rec)
+{
+    // selection by time: find the index'th newest record
+    uint32_t below {0xFFFFFFFF};
+    bool first {true};
+    for (uint8_t k=0; k<=index; ++k) {
+        bool found {false};
+        uint32_t best {0};
+        CAL_RECORD_t r;
+        for (uint8_t i=0; i<m_histPages; ++i) {
+            if (historySlot(i, r) && (first || r.time < below) && (!found || r.time > best)) {
+                best = r.time;
+                rec = r;
+                found = true;
+            }
+        }
+        if (!found) return false;
+        below = best;
+        first = false;
+    }
+    return true;
+}
+
+// Read a history slot. Returns false if it is empty or invalid.
+bool MCP79412Calibrator::historySlot(const uint8_t slot, CAL_RECORD_t& rec)
+{
+    m_rtc.eepromRead(m_histAddr + slot * MCP79412RTC::EEPROM_PAGE_SIZE,
+        reinterpret_cast<uint8_t*>(&rec), sizeof(rec));
+    return rec.time != 0xFFFFFFFF && (rec.flags & 0x7F) == check(rec);
+}
+
+// 7-bit check value over the record, excluding the check bits but
+// including the coarse trim bit. The top bit of the 8-bit sum is folded
+// into the bottom one, so any single bit error changes the check value.
+uint8_t MCP79412Calibrator::check(const CAL_RECORD_t& rec)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&rec);
+    uint8_t c {0x5A};
+    for (uint8_t i=0; i<sizeof(rec)-1; ++i) c = (c << 1 | c >> 7) ^ p[i];
+    c = (c << 1 | c >> 7) ^ rec.flags >> 7;
+    return (c ^ c >> 7) & 0x7F;
+}
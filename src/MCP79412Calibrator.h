@@ -0,0 +1,67 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Oscillator calibration from reference timestamps.
+// Each sample pairs a reference time (e.g. from NTP or GPS) with the
+// RTC's time at the same moment. A least-squares line through the
+// RTC's offset from the reference gives its rate error in ppm, and
+// apply() sets the OSCTRIM register (and the CRSTRIM coarse trim bit,
+// if the error is too large for fine trim) to cancel it. Each applied
+// calibration is recorded in a small history in the RTC's EEPROM.
+
+#ifndef MCP79412_CALIBRATOR_H_INCLUDED
+#define MCP79412_CALIBRATOR_H_INCLUDED
+
+#include <MCP79412RTC.h>
+
+class MCP79412Calibrator
+{
+    public:
+        static constexpr float
+            FINE_PPM {2.0 / 32768.0 / 60.0 * 1e6},  // ppm per OSCTRIM step, ~1.017
+            COARSE_PPM {FINE_PPM * 128 * 60};       // and with CRSTRIM set, ~7812
+        static constexpr uint8_t
+            HISTORY_ADDR {96},      // default EEPROM address for the history, after the default log
+            HISTORY_PAGES {4};      // and its size in pages (records)
+
+        // one calibration, as recorded in EEPROM (one page)
+        struct CAL_RECORD_t {
+            uint32_t time;          // reference time when applied
+            int16_t drift;          // measured rate error, 0.1 ppm
+            int8_t trim;            // OSCTRIM value written
+            uint8_t flags;          // bit 7: coarse trim, bits 0-6: check
+        };
+
+        MCP79412Calibrator(MCP79412RTC& rtc, const uint8_t historyAddr=HISTORY_ADDR,
+            const uint8_t historyPages=HISTORY_PAGES)
+            : m_rtc{rtc}, m_histAddr{historyAddr}, m_histPages{historyPages} {}
+        void addSample(const uint64_t refMs, const uint64_t rtcMs);
+        bool addSample(const time_t ref);
+        void reset() {m_n = 0;}
+        uint16_t samples() {return m_n;}
+        float span() {return m_span;}
+        float drift();
+        int16_t optimalTrim(bool& coarse);
+        bool apply();
+        uint8_t historyCount();
+        bool historyRead(const uint8_t index, CAL_RECORD_t& rec);
+
+    private:
+        MCP79412RTC& m_rtc;
+        uint8_t m_histAddr;
+        uint8_t m_histPages;
+        uint16_t m_n {0};           // number of samples
+        uint64_t m_ref0;            // first sample's reference time, ms
+        int64_t m_off0;             // and the RTC's offset from it, ms
+        float m_span;               // seconds from the first sample to the last
+        float m_mx, m_my;           // means: seconds since first sample, offset ms
+        float m_cxx, m_cxy;         // sums of squares and products of deviations
+        time_t m_lastRef;           // reference time of the last sample, s
+
+        bool historySlot(const uint8_t slot, CAL_RECORD_t& rec);
+        static int16_t roundTrim(const float v);
+        static uint8_t check(const CAL_RECORD_t& rec);
+};
+#endif
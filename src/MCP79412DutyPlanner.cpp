@@ -0,0 +1,226 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Duty-cycle planner, see MCP79412DutyPlanner.h.
+
+#include <MCP79412DutyPlanner.h>
+
+// Add a task, released every period seconds, first at the given time
+// (optional, default one period from now), and to be run within
+// deadline seconds after each release. The deadline must be less than
+// the period. Returns the task's id, or NONE if the arguments are not
+// valid or there are already MAX_TASKS.
+uint8_t MCP79412DutyPlanner::add(const uint32_t period, const uint32_t deadline, TASK_t task, const time_t first)
+{
+    if (!task || deadline >= period) return NONE;
+    uint8_t id {0};
+    while (id < MAX_TASKS && m_task[id]) ++id;
+    if (id >= MAX_TASKS) return NONE;
+    m_period[id] = period;
+    m_deadline[id] = deadline;
+    m_release[id] = first ? first : m_rtc.get() + period;
+    m_task[id] = task;
+    if (m_started && !m_waking) program(m_rtc.get());
+    return id;
+}
+
+// Remove a task. Returns false if there is no task with the given id.
+bool MCP79412DutyPlanner::remove(const uint8_t id)
+{
+    if (id >= MAX_TASKS || !m_task[id]) return false;
+    m_task[id] = nullptr;
+    if (m_started && !m_waking) program(m_rtc.get());
+    return true;
+}
+
+// Start waking for the tasks: run those that are already released,
+// and program the first wake time. The ALMPOL bit is kept.
+void MCP79412DutyPlanner::begin()
+{
+    m_pol = m_rtc.alarmPolarityBit(m_alarm);
+    m_written = 0;
+    m_next = 0;
+    m_enabled = false;
+    m_started = true;
+    wake();
+}
+
+// Stop, and disable the hardware alarm.
+void MCP79412DutyPlanner::end()
+{
+    if (m_enabled) m_rtc.setAlarmEnable(m_alarm, false);
+    m_enabled = false;
+    m_armed = true;
+    m_next = 0;
+    m_started = false;
+}
+
+// Run the tasks that have been released by the given time, and
+// program the next wake time. Call it when the alarm wakes the MCU.
+// A task that was missed is run once, for its latest release. A task
+// may add and remove tasks. If the next wake time is a second or less
+// away, the time is read again after programming it, in case it was
+// already reached by then. If the wake time cannot be programmed,
+// armed() is false and wake() should be called again. Returns the
+// number of tasks run.
+uint8_t MCP79412DutyPlanner::wake(time_t now)
+{
+    uint8_t n {0};
+    m_waking = true;
+    while (true) {
+        uint8_t due {advance(m_release, now)};
+        for (uint8_t i=0; i<MAX_TASKS; ++i) {
+            if ((due & _BV(i)) && m_task[i]) {
+                m_task[i](i);
+                ++n;
+            }
+        }
+        if (program(now) != 0) break;
+        if (m_next == 0 || m_next - now > 1) break;
+        now = m_rtc.get();
+        if (m_next > now) break;
+    }
+    m_waking = false;
+    return n;
+}
+
+// Work out the wakeups in the day from the given time, with the tasks
+// as they are now, and what they cost on the bus at the given I2C
+// clock: for each wakeup, a read of the time and a write of the alarm
+// registers, as wake() does. Does not use the bus.
+MCP79412DutyPlanner::BUDGET_t MCP79412DutyPlanner::budget(const time_t start, const uint32_t i2cHz) const
+{
+    BUDGET_t b {};
+    time_t release[MAX_TASKS];
+    memcpy(release, m_release, sizeof(release));
+    uint8_t last[6];
+    memcpy(last, m_last, sizeof(last));
+    uint8_t written {m_written};
+    uint32_t stops {0};
+    const time_t end = start + MCP7941xCivil::DAY_SECONDS;
+
+    for (time_t w = earliest(release); w != 0 && w < end; ) {
+        ++b.wakes;
+        b.transfers += 2;               // the register address, then read the time
+        b.bytes += 1 + tmNbrFields;
+        ++stops;
+        for (uint8_t due = advance(release, w); due; due &= due - 1) ++b.taskRuns;
+        time_t next = earliest(release);
+        if (next == 0) break;
+        uint8_t regs[tmNbrFields], lo, hi;
+        alarmRegs(w, next, last, written, regs, lo, hi);
+        for (uint8_t i=lo; i<=hi; ++i) {
+            last[i] = regs[i];
+            written |= _BV(i);
+        }
+        ++b.transfers;                  // the register address and the alarm registers
+        b.bytes += 1 + hi - lo + 1;
+        ++stops;
+        w = next;
+    }
+    // a START and the address byte, 9 bits for each data byte, and a STOP
+    b.busMicros = (10ULL * b.transfers + 9ULL * b.bytes + stops) * 1000000 / i2cHz;
+    return b;
+}
+
+// Print the budget for the day from the given time. If the current
+// drawn while the bus is busy is given, also print the charge.
+void MCP79412DutyPlanner::report(Print& p, const time_t start, const uint32_t i2cHz, const uint32_t busMicroamps) const
+{
+    BUDGET_t b {budget(start, i2cHz)};
+    p.print(F("wakes/day "));
+    p.print(b.wakes);
+    p.print(F(", task runs "));
+    p.print(b.taskRuns);
+    p.print(F(", I2C transfers "));
+    p.print(b.transfers);
+    p.print(F(", bytes "));
+    p.print(b.bytes);
+    p.print(F(", bus us "));
+    p.print(b.busMicros);
+    if (busMicroamps) {
+        p.print(F(", charge nAh "));
+        p.print(static_cast<uint32_t>(static_cast<uint64_t>(busMicroamps) * b.busMicros / 3600000));
+    }
+    p.println();
+}
+
+// Program the earliest deadline into the hardware alarm, enabling it
+// the first time, or disable the alarm if there are no tasks. If the
+// write fails, which registers it reached is not known, so all of them
+// are written next time.
+// Returns the I2C status (zero if successful).
+uint8_t MCP79412DutyPlanner::program(const time_t now)
+{
+    if (!m_started) return 0;
+    time_t next {earliest(m_release)};
+    m_next = next;
+    if (next == 0) {
+        if (m_enabled && m_rtc.setAlarmEnable(m_alarm, false) == 0) m_enabled = false;
+        m_armed = true;
+        return 0;
+    }
+    uint8_t regs[tmNbrFields], lo, hi;
+    alarmRegs(now, next, m_last, m_written, regs, lo, hi);
+    uint8_t e {m_rtc.writeRTC(MCP79412RTC::alarmRegister(m_alarm, MCP79412RTC::ALM0SEC + lo), regs + lo, hi - lo + 1)};
+    if (e == 0) {
+        for (uint8_t i=lo; i<=hi; ++i) {
+            m_last[i] = regs[i];
+            m_written |= _BV(i);
+        }
+        if (!m_enabled && (e = m_rtc.setAlarmEnable(m_alarm, true)) == 0) m_enabled = true;
+    }
+    else {
+        m_written = 0;
+    }
+    m_armed = (e == 0);
+    return e;
+}
+
+// Run the tasks in the given release times that have been released by
+// now, i.e. advance their releases past now. Returns a bit for each.
+uint8_t MCP79412DutyPlanner::advance(time_t* release, const time_t now) const
+{
+    uint8_t due {0};
+    for (uint8_t i=0; i<MAX_TASKS; ++i) {
+        if (m_task[i] && release[i] <= now) {
+            release[i] += ((now - release[i]) / m_period[i] + 1) * m_period[i];
+            due |= _BV(i);
+        }
+    }
+    return due;
+}
+
+// The earliest deadline for the given release times, zero if no tasks.
+time_t MCP79412DutyPlanner::earliest(const time_t* release) const
+{
+    time_t t {0};
+    for (uint8_t i=0; i<MAX_TASKS; ++i) {
+        if (m_task[i] && (t == 0 || release[i] + m_deadline[i] < t)) t = release[i] + m_deadline[i];
+    }
+    return t;
+}
+
+// The alarm registers (ALMxSEC through ALMxMTH) for the given wake
+// time, and the span of them to write: from lo through hi, covering
+// ALMxWKDAY, which has the match mode and the flag, and the registers
+// that the match mode uses that were not written before or differ
+// from those last written.
+void MCP79412DutyPlanner::alarmRegs(const time_t now, const time_t wake, const uint8_t* last, const uint8_t written,
+                                    uint8_t* regs, uint8_t& lo, uint8_t& hi) const
+{
+    // registers used by each match mode, other than ALMxWKDAY
+    static constexpr uint8_t used[] {0x01, 0x02, 0x04, 0x00, 0x10, 0x00, 0x00, 0x37};
+    MCP79412RTC::ALARM_TYPES_t mode {MCP79412Scheduler::matchMode(now, wake)};
+    MCP7941xCivil::timeToRegs(wake, regs);
+    regs[3] |= m_pol | mode << 4;       // ALMxIF == 0
+    lo = hi = 3;
+    for (uint8_t i=0; i<6; ++i) {
+        if ((used[mode] & _BV(i)) && (!(written & _BV(i)) || last[i] != regs[i])) {
+            if (i < lo) lo = i;
+            if (i > hi) hi = i;
+        }
+    }
+}
@@ -0,0 +1,85 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Duty-cycle planner: wakes the MCU with an RTC alarm as seldom as a
+// set of periodic tasks allows. Each task is released once a period
+// and must run within its deadline (seconds of slack) after the
+// release. The planner wakes at the latest time that meets the most
+// urgent deadline, and runs every task that has been released by then,
+// so tasks with overlapping windows share a wakeup. (Waking at the
+// earliest deadline is the optimal greedy choice: no plan meets the
+// deadlines with fewer wakeups.)
+//
+// The wake time is programmed with the least specific match mode that
+// fires exactly then (see MCP79412Scheduler::matchMode()), and only the
+// alarm registers that the match mode uses and that differ from what
+// was last written are written, with ALMxWKDAY (which has the match
+// mode and clears the flag), in one transfer. So a wakeup costs a read
+// of the time and a write of one to seven bytes. budget() works out
+// the wakeups per day and what they cost on the bus, without using it.
+// If programming the alarm fails, armed() is false: call wake() again
+// rather than sleeping, since no alarm would wake the MCU. The planner
+// owns its hardware alarm; the other one is free for other
+// uses.
+
+#ifndef MCP79412_DUTYPLANNER_H_INCLUDED
+#define MCP79412_DUTYPLANNER_H_INCLUDED
+
+#include <MCP79412RTC.h>
+#include <MCP79412Scheduler.h>
+
+class MCP79412DutyPlanner
+{
+    public:
+        static constexpr uint8_t
+            MAX_TASKS {8},
+            NONE {0xFF};                // not a valid task id
+        typedef void (*TASK_t)(const uint8_t id);
+
+        // the cost of a day of wakeups
+        struct BUDGET_t {
+            uint32_t wakes;             // wakeups
+            uint32_t taskRuns;          // task runs, i.e. wakeups without batching
+            uint32_t transfers;         // I2C transfers (address phases)
+            uint32_t bytes;             // I2C data bytes, excluding address bytes
+            uint32_t busMicros;         // time the bus is busy, at the given clock
+        };
+
+        MCP79412DutyPlanner(MCP79412RTC& rtc, const MCP79412RTC::ALARM_NBR_t alarmNumber=MCP79412RTC::ALARM_0)
+            : m_rtc{rtc}, m_alarm{alarmNumber} {}
+        uint8_t add(const uint32_t period, const uint32_t deadline, TASK_t task, const time_t first=0);
+        bool remove(const uint8_t id);
+        void begin();
+        void end();
+        uint8_t wake() {return wake(m_rtc.get());}
+        uint8_t wake(time_t now);
+        time_t nextWake() {return m_next;}
+        bool armed() {return m_armed;}
+        BUDGET_t budget(const time_t start, const uint32_t i2cHz=100000) const;
+        void report(Print& p, const time_t start, const uint32_t i2cHz=100000, const uint32_t busMicroamps=0) const;
+
+    private:
+        MCP79412RTC& m_rtc;
+        MCP79412RTC::ALARM_NBR_t m_alarm;
+        uint32_t m_period[MAX_TASKS];
+        uint32_t m_deadline[MAX_TASKS];     // seconds after the release
+        time_t m_release[MAX_TASKS];        // next release of each task
+        TASK_t m_task[MAX_TASKS] {};        // nullptr if the id is free
+        time_t m_next {0};                  // programmed wake time, zero if none
+        uint8_t m_last[6];                  // alarm registers last written
+        uint8_t m_written {0};              // bits for the registers in m_last that were written
+        uint8_t m_pol {0};                  // ALMPOL bit, see MCP79412RTC::alarmPolarityBit()
+        bool m_started {false};
+        bool m_enabled {false};             // hardware alarm enabled
+        bool m_armed {true};                // the wake time is programmed, or there is none
+        bool m_waking {false};              // in wake(), which programs at the end
+
+        uint8_t program(const time_t now);
+        uint8_t advance(time_t* release, const time_t now) const;
+        time_t earliest(const time_t* release) const;
+        void alarmRegs(const time_t now, const time_t wake, const uint8_t* last, const uint8_t written,
+                       uint8_t* regs, uint8_t& lo, uint8_t& hi) const;
+};
+#endif
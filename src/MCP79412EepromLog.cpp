@@ -0,0 +1,126 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Wear-leveled EEPROM ring log, see MCP79412EepromLog.h.
+//
+// Page layout: [0] sequence number, [1..size] data,
+// [size+1..6] 0xFF, [7] CRC-8 of bytes 0-6.
+
+#include <MCP79412EepromLog.h>
+
+// The record size is limited to RECORD_MAX bytes and the ring to the
+// pages that fit in the EEPROM. The ring has at least two pages, so it
+// starts no later than the second-to-last page.
+MCP79412EepromLog::MCP79412EepromLog(MCP79412RTC& rtc, const uint8_t recordSize,
+    const uint8_t firstPage, const uint8_t nPages)
+    : m_rtc{rtc}
+{
+    m_size = recordSize > RECORD_MAX ? RECORD_MAX : recordSize;
+    m_first = firstPage < MAX_PAGES - 1 ? firstPage : MAX_PAGES - 2;
+    m_nPages = nPages;
+    if (m_first + m_nPages > MAX_PAGES) m_nPages = MAX_PAGES - m_first;
+    if (m_nPages < 2) m_nPages = 2;
+}
+
+// Find the newest record and count the records, with one bulk read of
+// the ring. The newest record is the one that is not followed by the
+// next sequence number. Returns the number of records.
+uint8_t MCP79412EepromLog::begin()
+{
+    uint8_t buf[MCP79412RTC::EEPROM_SIZE];
+    m_count = 0;
+    m_head = m_nPages - 1;
+    if (m_rtc.eepromReadBulk(pageAddr(0), buf, m_nPages * PAGE_SIZE) != 0) return 0;
+
+    for (uint8_t i=0; i<m_nPages; ++i) {
+        uint8_t* p = buf + i * PAGE_SIZE;
+        uint8_t* next = buf + ((i + 1) % m_nPages) * PAGE_SIZE;
+        if (valid(p) && !(valid(next) && next[0] == static_cast<uint8_t>(p[0] + 1))) {
+            m_head = i;
+            m_seq = p[0];
+            break;
+        }
+    }
+    // count back from the head while the sequence is unbroken
+    uint8_t i {m_head};
+    uint8_t seq {m_seq};
+    while (m_count < m_nPages) {
+        uint8_t* p = buf + i * PAGE_SIZE;
+        if (!valid(p) || p[0] != seq) break;
+        ++m_count;
+        --seq;
+        i = (i == 0) ? m_nPages - 1 : i - 1;
+    }
+    return m_count;
+}
+
+// Append a record, overwriting the oldest if the ring is full.
+// One page write; waits for the write cycle to complete.
+// Returns the I2C status (zero if successful).
+uint8_t MCP79412EepromLog::append(const void* record)
+{
+    uint8_t page[PAGE_SIZE];
+    memset(page, 0xFF, sizeof(page));
+    page[0] = m_count ? m_seq + 1 : 0;
+    memcpy(page + 1, record, m_size);
+    page[PAGE_SIZE - 1] = crc8(page, PAGE_SIZE - 1);
+
+    uint8_t next = (m_head + 1) % m_nPages;
+    uint8_t e = m_rtc.eepromWriteBulk(pageAddr(next), page, PAGE_SIZE);
+    if (e == 0) {
+        m_head = next;
+        m_seq = page[0];
+        if (m_count < m_nPages) ++m_count;
+    }
+    return e;
+}
+
+// Read a record, index 0 being the newest. Returns false if there is
+// no such record, or it cannot be read or fails its CRC.
+bool MCP79412EepromLog::read(const uint8_t index, void* record)
+{
+    if (index >= m_count) return false;
+    uint8_t i = (m_head + m_nPages - index) % m_nPages;
+    uint8_t page[PAGE_SIZE];
+    if (m_rtc.eepromReadBulk(pageAddr(i), page, PAGE_SIZE) != 0) return false;
+    if (!valid(page) || page[0] != static_cast<uint8_t>(m_seq - index)) return false;
+    memcpy(record, page + 1, m_size);
+    return true;
+}
+
+// Erase the log by writing every page of the ring to 0xFF.
+// Returns the I2C status (zero if successful).
+uint8_t MCP79412EepromLog::clear()
+{
+    uint8_t page[PAGE_SIZE];
+    memset(page, 0xFF, sizeof(page));
+    uint8_t e {0};
+    for (uint8_t i=0; i<m_nPages && e == 0; ++i) {
+        e = m_rtc.eepromWriteBulk(pageAddr(i), page, PAGE_SIZE);
+    }
+    m_count = 0;
+    m_head = m_nPages - 1;
+    return e;
+}
+
+// Check a page's CRC. An erased page never passes.
+bool MCP79412EepromLog::valid(const uint8_t* page)
+{
+    return page[PAGE_SIZE - 1] == crc8(page, PAGE_SIZE - 1);
+}
+
+// CRC-8, polynomial 0x07, initial value 0x00, final XOR 0x55. The final
+// XOR gives an erased (all 0xFF) page a CRC other than 0xFF.
+uint8_t MCP79412EepromLog::crc8(const uint8_t* data, const uint8_t len)
+{
+    uint8_t crc {0};
+    for (uint8_t i=0; i<len; ++i) {
+        crc ^= data[i];
+        for (uint8_t b=0; b<8; ++b) {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+        }
+    }
+    return crc ^ 0x55;
+}
@@ -0,0 +1,51 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// A log of fixed-size records in a ring of EEPROM pages.
+// Each record occupies one page: a sequence number, up to six bytes of
+// data, and a CRC-8. Appending a record costs exactly one page write
+// cycle, and successive records go to successive pages, so the writes
+// are spread evenly over the ring. begin() reads the whole ring in one
+// bulk read and finds the newest record where the sequence numbers
+// break. A record torn by a power failure during its write fails its
+// CRC and is simply not part of the log.
+
+#ifndef MCP79412_EEPROM_LOG_H_INCLUDED
+#define MCP79412_EEPROM_LOG_H_INCLUDED
+
+#include <MCP79412RTC.h>
+
+class MCP79412EepromLog
+{
+    public:
+        static constexpr uint8_t
+            PAGE_SIZE {MCP79412RTC::EEPROM_PAGE_SIZE},
+            MAX_PAGES {MCP79412RTC::EEPROM_SIZE / PAGE_SIZE},
+            DEFAULT_PAGES {MAX_PAGES - 4},  // leaves pages 12-15 for the calibration history
+            RECORD_MAX {PAGE_SIZE - 2};     // data bytes per record, max
+
+        MCP79412EepromLog(MCP79412RTC& rtc, const uint8_t recordSize,
+            const uint8_t firstPage=0, const uint8_t nPages=DEFAULT_PAGES);
+        uint8_t begin();
+        uint8_t append(const void* record);
+        bool read(const uint8_t index, void* record);
+        uint8_t count() {return m_count;}
+        uint8_t capacity() {return m_nPages;}
+        uint8_t clear();
+
+    private:
+        MCP79412RTC& m_rtc;
+        uint8_t m_size;             // data bytes per record
+        uint8_t m_first;            // first page of the ring
+        uint8_t m_nPages;           // pages in the ring
+        uint8_t m_head {0};         // page index of the newest record
+        uint8_t m_count {0};        // number of records
+        uint8_t m_seq {0};          // sequence number of the newest record
+
+        uint8_t pageAddr(const uint8_t page) {return (m_first + page) * PAGE_SIZE;}
+        bool valid(const uint8_t* page);
+        static uint8_t crc8(const uint8_t* data, const uint8_t len);
+};
+#endif
@@ -0,0 +1,72 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Write-back EEPROM mirror, see MCP79412EepromMirror.h.
+
+#include <MCP79412EepromMirror.h>
+
+// Load the mirror from the EEPROM with one bulk read.
+// Returns the I2C status (zero if successful).
+uint8_t MCP79412EepromMirror::begin()
+{
+    m_dirty = 0;
+    m_written = 0;
+    return m_rtc.eepromReadBulk(0, m_data, SIZE);
+}
+
+// Copy bytes from the mirror. Returns false (and copies nothing) if
+// addr + nBytes would go past the end of the EEPROM.
+bool MCP79412EepromMirror::read(const uint8_t addr, void* values, const uint8_t nBytes)
+{
+    if (addr + nBytes > SIZE) return false;
+    memcpy(values, m_data + addr, nBytes);
+    return true;
+}
+
+// Change bytes in the mirror, marking the pages of the bytes that
+// change as dirty. Nothing is written to the EEPROM until flush().
+// Returns false (and changes nothing) if addr + nBytes would go past
+// the end of the EEPROM.
+bool MCP79412EepromMirror::write(const uint8_t addr, const void* values, const uint8_t nBytes)
+{
+    if (addr + nBytes > SIZE) return false;
+    const uint8_t* v = static_cast<const uint8_t*>(values);
+    for (uint8_t i=0; i<nBytes; ++i) {
+        uint8_t a = addr + i;
+        if (m_data[a] != v[i]) {
+            m_data[a] = v[i];
+            m_dirty |= 1U << (a / PAGE_SIZE);
+        }
+    }
+    return true;
+}
+
+// Write the dirty pages to the EEPROM. Each dirty page is first read
+// back, and only the bytes from the first that differs to the last are
+// written, in one write cycle; a page that matches the EEPROM is not
+// written at all. Waits for each write cycle to complete. A page that
+// fails stays dirty, so flush() can be called again.
+// Returns the I2C status (zero if successful).
+uint8_t MCP79412EepromMirror::flush()
+{
+    m_written = 0;
+    for (uint8_t p=0; p<PAGES && m_dirty; ++p) {
+        if ( !(m_dirty & (1U << p)) ) continue;
+        uint8_t addr = p * PAGE_SIZE;
+        uint8_t dev[PAGE_SIZE];
+        if ( uint8_t e = m_rtc.eepromReadBulk(addr, dev, PAGE_SIZE) ) return e;
+        uint8_t first {0};
+        uint8_t last {PAGE_SIZE};
+        while (first < PAGE_SIZE && dev[first] == m_data[addr + first]) ++first;
+        if (first < PAGE_SIZE) {
+            while (dev[last - 1] == m_data[addr + last - 1]) --last;
+            uint8_t e = m_rtc.eepromWriteBulk(addr + first, m_data + addr + first, last - first);
+            if (e) return e;
+            ++m_written;
+        }
+        m_dirty &= ~(1U << p);
+    }
+    return 0;
+}
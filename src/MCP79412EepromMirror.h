@@ -0,0 +1,48 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// A write-back copy of the MCP7941x EEPROM in RAM.
+// begin() loads all 128 bytes in one bulk read. After that, reads are
+// served from RAM with no I2C traffic, and writes change only RAM and
+// mark the 8-byte pages that they change as dirty. flush() writes the
+// dirty pages whose contents actually differ from the EEPROM, one
+// write cycle per page, so a value that is changed and changed back,
+// or written many times between flushes, costs at most one write
+// cycle per page.
+
+#ifndef MCP79412_EEPROM_MIRROR_H_INCLUDED
+#define MCP79412_EEPROM_MIRROR_H_INCLUDED
+
+#include <MCP79412RTC.h>
+
+class MCP79412EepromMirror
+{
+    public:
+        static constexpr uint8_t
+            SIZE {MCP79412RTC::EEPROM_SIZE},
+            PAGE_SIZE {MCP79412RTC::EEPROM_PAGE_SIZE},
+            PAGES {SIZE / PAGE_SIZE};
+
+        MCP79412EepromMirror(MCP79412RTC& rtc) : m_rtc{rtc} {}
+        uint8_t begin();
+        uint8_t read(const uint8_t addr) {return m_data[addr & (SIZE - 1)];}
+        bool read(const uint8_t addr, void* values, const uint8_t nBytes);
+        void write(const uint8_t addr, const uint8_t value) {write(addr, &value, 1);}
+        bool write(const uint8_t addr, const void* values, const uint8_t nBytes);
+        template <typename T> bool get(const uint8_t addr, T& t) {return read(addr, &t, sizeof(T));}
+        template <typename T> bool put(const uint8_t addr, const T& t) {return write(addr, &t, sizeof(T));}
+        bool isDirty() {return m_dirty != 0;}
+        uint8_t flush();
+        uint8_t pagesWritten() {return m_written;}
+        const uint8_t* data() {return m_data;}
+
+    private:
+        MCP79412RTC& m_rtc;
+        uint8_t m_data[SIZE];
+        uint16_t m_dirty {0};       // one bit per page
+        uint8_t m_written {0};      // pages written by the last flush()
+        static_assert(PAGES <= 16, "dirty page bits");
+};
+#endif
@@ -0,0 +1,108 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Non-blocking writes to the MCP7941x EEPROM, see MCP79412EepromWriter.h.
+
+#include <MCP79412EepromWriter.h>
+
+// Queue bytes to be written to EEPROM, starting at any address.
+// The data is split at page boundaries and copied, so the caller's
+// buffer can be reused immediately. Returns false (and queues nothing)
+// if the address range is invalid or there is not enough room in the
+// queue for all of the pages; call poll() until there is.
+bool MCP79412EepromWriter::write(const uint8_t addr, const uint8_t* values, const uint8_t nBytes)
+{
+    constexpr uint8_t pageSize {MCP79412RTC::EEPROM_PAGE_SIZE};
+    if (nBytes < 1 || addr + nBytes > MCP79412RTC::EEPROM_SIZE) return false;
+    uint8_t nPages = ( (addr & (pageSize - 1)) + nBytes + pageSize - 1 ) / pageSize;
+    if (nPages > available()) return false;
+
+    if (m_count == 0) {
+        m_status = EE_BUSY;
+        m_i2cStatus = 0;
+        m_writing = false;
+        m_msStart = millis();
+    }
+    uint8_t a {addr};
+    uint8_t n {nBytes};
+    while (n > 0) {
+        page_t& p = m_queue[(m_head + m_count) % QUEUE_PAGES];
+        uint8_t len = pageSize - (a & (pageSize - 1));
+        if (len > n) len = n;
+        p.addr = a;
+        p.nBytes = len;
+        memcpy(p.data, values, len);
+        ++m_count;
+        values += len;
+        a += len;
+        n -= len;
+    }
+    return true;
+}
+
+// Advance the queue. Call frequently, e.g. from loop(). Each call costs
+// at most one acknowledge poll and one page write on the bus, and
+// never waits. Returns the current status.
+MCP79412EepromWriter::EE_STATUS_t MCP79412EepromWriter::poll()
+{
+    if (m_count == 0) return m_status;
+
+    if (m_writing) {
+        if ( !m_rtc.eepromReady() ) {
+            if (millis() - m_msStart > m_timeout) fail(EE_TIMEOUT);
+            return m_status;
+        }
+        // head page is written
+        m_writing = false;
+        m_head = (m_head + 1) % QUEUE_PAGES;
+        if (--m_count == 0) {
+            m_status = EE_IDLE;
+            return m_status;
+        }
+        m_msStart = millis();
+    }
+
+    // start the next page. the EEPROM does not acknowledge its address
+    // while a write cycle (perhaps one started elsewhere) is in progress.
+    page_t& p = m_queue[m_head];
+    uint8_t e = m_rtc.eepromWritePage(p.addr, p.data, p.nBytes);
+    if (e == 0) {
+        m_writing = true;
+    }
+    else if (e != MCP79412RTC::I2C_NACK_ADDR) {
+        m_i2cStatus = e;
+        fail(EE_ERROR);
+    }
+    else if (millis() - m_msStart > m_timeout) {
+        m_i2cStatus = e;
+        fail(EE_TIMEOUT);
+    }
+    return m_status;
+}
+
+// Call poll() until the queue is empty, i.e. a blocking write-through.
+// Returns the final status.
+MCP79412EepromWriter::EE_STATUS_t MCP79412EepromWriter::flush()
+{
+    while (m_count > 0) poll();
+    return m_status;
+}
+
+// Discard queued pages. A write cycle already started will still
+// complete in the EEPROM.
+void MCP79412EepromWriter::cancel()
+{
+    m_count = 0;
+    m_writing = false;
+    m_status = EE_IDLE;
+}
+
+// Abandon the queue and record the reason.
+void MCP79412EepromWriter::fail(const EE_STATUS_t status)
+{
+    m_count = 0;
+    m_writing = false;
+    m_status = status;
+}
@@ -0,0 +1,63 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Non-blocking writes to the MCP7941x EEPROM.
+// write() queues data and returns immediately. poll(), called from
+// loop(), starts each page write and then acknowledge-polls the EEPROM,
+// starting the next page only when the previous write cycle is
+// complete. Nothing ever waits for the ~5ms write cycle, and a write
+// cycle that does not complete within the timeout is reported instead
+// of hanging.
+
+#ifndef MCP79412_EEPROM_WRITER_H_INCLUDED
+#define MCP79412_EEPROM_WRITER_H_INCLUDED
+
+#include <MCP79412RTC.h>
+
+class MCP79412EepromWriter
+{
+    public:
+        // values returned by status()
+        enum EE_STATUS_t {
+            EE_IDLE,        // queue empty, last write (if any) succeeded
+            EE_BUSY,        // writes are queued or in progress
+            EE_TIMEOUT,     // a write cycle did not complete in time
+            EE_ERROR        // I2C error, see i2cStatus()
+        };
+
+        static constexpr uint8_t QUEUE_PAGES {4};   // max pages queued
+
+        MCP79412EepromWriter(MCP79412RTC& rtc, const uint16_t timeoutMs=MCP79412RTC::EEPROM_TIMEOUT_MS)
+            : m_rtc{rtc}, m_timeout{timeoutMs} {}
+        bool write(const uint8_t addr, const uint8_t* values, const uint8_t nBytes);
+        bool write(const uint8_t addr, const uint8_t value) {return write(addr, &value, 1);}
+        EE_STATUS_t poll();
+        bool isBusy() {return m_count > 0;}
+        EE_STATUS_t status() {return m_status;}
+        uint8_t i2cStatus() {return m_i2cStatus;}
+        uint8_t available() {return QUEUE_PAGES - m_count;}
+        EE_STATUS_t flush();
+        void cancel();
+
+    private:
+        struct page_t {
+            uint8_t addr;
+            uint8_t nBytes;
+            uint8_t data[MCP79412RTC::EEPROM_PAGE_SIZE];
+        };
+
+        MCP79412RTC& m_rtc;
+        uint16_t m_timeout;         // max ms for a page, including waiting to start it
+        page_t m_queue[QUEUE_PAGES];
+        uint8_t m_head {0};         // index of the page being written
+        uint8_t m_count {0};        // number of pages queued, including the one being written
+        bool m_writing {false};     // write cycle started for the head page
+        uint32_t m_msStart;         // time the head page became current
+        EE_STATUS_t m_status {EE_IDLE};
+        uint8_t m_i2cStatus {0};
+
+        void fail(const EE_STATUS_t status);
+};
+#endif
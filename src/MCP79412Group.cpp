@@ -0,0 +1,227 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// A group of redundant RTCs, see MCP79412Group.h.
+
+#include <MCP79412Group.h>
+
+// Add an RTC to the group, on the bus it was constructed with. For an
+// RTC behind a multiplexer, give its channel (0-7) and the
+// multiplexer's address; the multiplexer is on the same bus.
+// Returns false if the group is full, there are too many
+// multiplexers, or the channel is not valid.
+bool MCP79412Group::add(MCP79412RTC& rtc, const uint8_t channel, const uint8_t muxAddr)
+{
+    if (m_n >= MAX_RTCS || (channel != NO_MUX && channel > 7)) return false;
+    TwoWire& bus = rtc.twoWire();
+
+    int8_t mux {-1};
+    if (channel != NO_MUX) {
+        for (uint8_t k=0; k<m_nMux; ++k) {
+            if (m_mux[k].bus == &bus && m_mux[k].addr == muxAddr) mux = k;
+        }
+        if (mux < 0) {
+            if (m_nMux >= MAX_MUXES) return false;
+            m_mux[m_nMux] = {&bus, muxAddr, -1};
+            mux = m_nMux++;
+        }
+    }
+    uint8_t i {m_n++};
+    m_rtc[i] = {&rtc, mux, channel, 0, false, 0};
+    m_bus[i] = &bus;
+
+    // insert into the access order
+    uint8_t j {i};
+    while (j > 0 && before(i, m_order[j - 1])) {
+        m_order[j] = m_order[j - 1];
+        --j;
+    }
+    m_order[j] = i;
+    return true;
+}
+
+// Select an RTC's multiplexer channel, if need be, and return the RTC.
+// Returns nullptr if there is no RTC with the given index or its
+// channel could not be selected. With bus locks (see
+// MCP79412RTC::setBusLock()), hold the RTC's lock around the call and
+// the use of the RTC, so that another task cannot change the channel
+// in between.
+MCP79412RTC* MCP79412Group::select(const uint8_t index)
+{
+    if (index >= m_n || !route(index)) return nullptr;
+    return m_rtc[index].rtc;
+}
+
+// Read all of the RTCs, then find the consensus (median) time and the
+// outliers, i.e. the RTCs whose times differ from it by more than the
+// tolerance. An RTC that cannot be read has a time of zero and is
+// neither counted nor an outlier.
+// Returns the number of RTCs read.
+uint8_t MCP79412Group::readAll()
+{
+    time_t sorted[MAX_RTCS];
+    uint8_t nValid {0};
+    for (uint8_t k=0; k<m_n; ++k) {
+        rtc_t& r = m_rtc[m_order[k]];
+        MCP79412BusGuard guard(r.rtc->getBusLock());
+        r.t = route(m_order[k]) ? r.rtc->get() : 0;
+        if (r.t == 0) continue;
+        // insertion sort as we go
+        uint8_t j {nValid++};
+        while (j > 0 && sorted[j - 1] > r.t) {
+            sorted[j] = sorted[j - 1];
+            --j;
+        }
+        sorted[j] = r.t;
+    }
+
+    m_outliers = 0;
+    m_consensus = 0;
+    if (nValid > 0) {
+        uint8_t mid = nValid / 2;
+        m_consensus = (nValid & 1) ? sorted[mid] : sorted[mid - 1] + (sorted[mid] - sorted[mid - 1]) / 2;
+    }
+    for (uint8_t i=0; i<m_n; ++i) {
+        rtc_t& r = m_rtc[i];
+        uint32_t diff = r.t > m_consensus ? r.t - m_consensus : m_consensus - r.t;
+        r.outlier = r.t != 0 && diff > m_tolerance;
+        if (r.outlier) ++m_outliers;
+    }
+    return nValid;
+}
+
+// Set all of the RTCs to the given time. First the time registers of
+// every RTC are written with its oscillator stopped, then the
+// oscillators are started one after another with a one-byte write to
+// each, so the RTCs start counting within a fraction of a millisecond
+// of each other. The time given is the time at which the oscillators
+// start. skew() then gives the measured time from starting RTC 0's
+// oscillator to starting each of the others (negative if it was
+// started first).
+// Returns the first I2C error (zero if successful); an error does not
+// stop the other RTCs from being set.
+uint8_t MCP79412Group::setAll(const time_t t)
+{
+    uint8_t regs[tmNbrFields];
+    MCP7941xCivil::timeToRegs(t, regs);     // 24 hour format
+    uint8_t sec = regs[0] | _BV(MCP79412RTC::STOSC);
+    regs[0] = 0x00;                         // stops the oscillator (STOSC == 0)
+    regs[3] |= _BV(MCP79412RTC::VBATEN);    // enable battery backup
+
+    uint8_t err {0};
+    bool ok[MAX_RTCS];
+    for (uint8_t k=0; k<m_n; ++k) {
+        uint8_t i {m_order[k]};
+        MCP79412BusGuard guard(m_rtc[i].rtc->getBusLock());
+        uint8_t e = route(i) ? m_rtc[i].rtc->writeRTC(MCP79412RTC::RTCSEC, regs, sizeof(regs)) : 4;
+        ok[i] = e == 0;
+        if (err == 0) err = e;
+    }
+    uint32_t start[MAX_RTCS];
+    for (uint8_t k=0; k<m_n; ++k) {
+        uint8_t i {m_order[k]};
+        if (!ok[i]) continue;
+        MCP79412BusGuard guard(m_rtc[i].rtc->getBusLock());
+        uint8_t e = route(i) ? m_rtc[i].rtc->writeRTC(MCP79412RTC::RTCSEC, sec) : 4;
+        start[i] = micros();
+        ok[i] = e == 0;
+        if (err == 0) err = e;
+    }
+    for (uint8_t i=0; i<m_n; ++i) {
+        m_rtc[i].skew = (ok[i] && ok[0]) ? static_cast<int32_t>(start[i] - start[0]) : 0;
+    }
+    return err;
+}
+
+// Measure the skew between the RTCs by watching for each one's seconds
+// register to change. The RTCs are read in turn, and each one's tick is
+// taken as the midpoint between the last read before its seconds
+// changed and the first read after, so the resolution is the time to
+// read all of them once. skew() then gives the microseconds by which
+// each RTC ticks after RTC 0. Returns false if any RTC could
+// not be read, or did not tick within the timeout.
+bool MCP79412Group::measureSkew(const uint16_t timeoutMs)
+{
+    uint8_t sec[MAX_RTCS];
+    uint32_t last[MAX_RTCS];
+    uint32_t tick[MAX_RTCS];
+    bool done[MAX_RTCS];
+    for (uint8_t k=0; k<m_n; ++k) {
+        uint8_t i {m_order[k]};
+        MCP79412BusGuard guard(m_rtc[i].rtc->getBusLock());
+        if ( !route(i) || m_rtc[i].rtc->readRTC(MCP79412RTC::RTCSEC, sec + i, 1) != 0 ) return false;
+        last[i] = micros();
+        done[i] = false;
+    }
+    uint8_t remaining {m_n};
+    uint32_t msStart = millis();
+    while (remaining > 0 && millis() - msStart < timeoutMs) {
+        for (uint8_t k=0; k<m_n; ++k) {
+            uint8_t i {m_order[k]};
+            if (done[i]) continue;
+            uint8_t s;
+            MCP79412BusGuard guard(m_rtc[i].rtc->getBusLock());
+            if ( !route(i) || m_rtc[i].rtc->readRTC(MCP79412RTC::RTCSEC, &s, 1) != 0 ) return false;
+            uint32_t now = micros();
+            if (s != sec[i]) {
+                tick[i] = last[i] + (now - last[i]) / 2;
+                done[i] = true;
+                --remaining;
+            }
+            last[i] = now;
+        }
+    }
+    if (remaining > 0) return false;
+    for (uint8_t i=0; i<m_n; ++i) {
+        m_rtc[i].skew = static_cast<int32_t>(tick[i] - tick[0]);
+    }
+    return true;
+}
+
+// Forget which channels the multiplexers have selected, e.g. after
+// something other than the group has changed them. Each is written
+// again before its next use.
+void MCP79412Group::invalidate()
+{
+    for (uint8_t k=0; k<m_nMux; ++k) m_mux[k].selected = -1;
+}
+
+// Make an RTC the only one at the RTC address on its bus: select its
+// channel on its multiplexer, and no channel on any other multiplexer
+// on the same bus. Only multiplexers whose selection changes are
+// written. Returns false on an I2C error.
+bool MCP79412Group::route(const uint8_t index)
+{
+    const rtc_t& r = m_rtc[index];
+    for (uint8_t k=0; k<m_nMux; ++k) {
+        mux_t& m = m_mux[k];
+        if (m.bus != m_bus[index]) continue;
+        uint8_t want = (r.mux == k) ? _BV(r.channel) : 0;
+        if (m.selected != want && !muxWrite(m, want)) return false;
+    }
+    return true;
+}
+
+// Write a multiplexer's channel selection register.
+bool MCP79412Group::muxWrite(mux_t& m, const uint8_t mask)
+{
+    m.bus->beginTransmission(m.addr);
+    m.bus->write(mask);
+    bool ok = m.bus->endTransmission() == 0;
+    m.selected = ok ? mask : -1;
+    return ok;
+}
+
+// Access order: by bus, then RTCs not behind a multiplexer (so that
+// no multiplexer needs to be switched off between them), then by
+// multiplexer and channel.
+bool MCP79412Group::before(const uint8_t a, const uint8_t b)
+{
+    uintptr_t busA = reinterpret_cast<uintptr_t>(m_bus[a]);
+    uintptr_t busB = reinterpret_cast<uintptr_t>(m_bus[b]);
+    if (busA != busB) return busA < busB;
+    if (m_rtc[a].mux != m_rtc[b].mux) return m_rtc[a].mux < m_rtc[b].mux;
+    return m_rtc[a].channel < m_rtc[b].channel;
+}
@@ -0,0 +1,85 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// A group of redundant MCP7941x RTCs.
+// Since every MCP7941x has the same I2C address, several RTCs must be
+// on separate buses (Wire, Wire1, ...) or behind an I2C multiplexer
+// such as the TCA9548A. The group reads all of the RTCs, takes the
+// median of their times as the consensus time, and flags any RTC that
+// disagrees with it by more than a tolerance as an outlier. setAll()
+// sets all of the RTCs so that their oscillators start as close
+// together as possible, and records the skew between them.
+//
+// The RTCs are read in order of bus, multiplexer and channel, and the
+// group remembers which channel each multiplexer has selected, so a
+// channel is selected only when it changes and is never deselected
+// except to avoid a conflict with another RTC on the same bus. Reading
+// N RTCs behind one multiplexer costs N burst reads plus at most N
+// channel selections, and none if there is one RTC per bus.
+// Use select() to access an individual RTC, so the group knows about
+// any channel change. RTCs that share a bus should share a bus lock,
+// if any, see MCP79412BusLock.h.
+
+#ifndef MCP79412_GROUP_H_INCLUDED
+#define MCP79412_GROUP_H_INCLUDED
+
+#include <MCP79412RTC.h>
+
+class MCP79412Group
+{
+    public:
+        static constexpr uint8_t
+            MAX_RTCS {8},
+            MAX_MUXES {4},
+            NO_MUX {0xFF},          // channel for an RTC not behind a multiplexer
+            MUX_ADDR {0x70};        // default TCA9548A address
+        static constexpr uint32_t DEFAULT_TOLERANCE {2};    // seconds
+
+        MCP79412Group(const uint32_t tolerance=DEFAULT_TOLERANCE) : m_tolerance{tolerance} {}
+        bool add(MCP79412RTC& rtc, const uint8_t channel=NO_MUX, const uint8_t muxAddr=MUX_ADDR);
+        uint8_t count() {return m_n;}
+        MCP79412RTC* select(const uint8_t index);
+        uint8_t readAll();
+        time_t consensus() {return m_consensus;}
+        time_t time(const uint8_t index) {return index < m_n ? m_rtc[index].t : 0;}
+        bool isValid(const uint8_t index) {return time(index) != 0;}
+        bool isOutlier(const uint8_t index) {return index < m_n && m_rtc[index].outlier;}
+        uint8_t outliers() {return m_outliers;}
+        void setTolerance(const uint32_t seconds) {m_tolerance = seconds;}
+        uint8_t setAll(const time_t t);
+        bool measureSkew(const uint16_t timeoutMs=1100);
+        int32_t skew(const uint8_t index) {return index < m_n ? m_rtc[index].skew : 0;}
+        void invalidate();
+
+    private:
+        struct rtc_t {
+            MCP79412RTC* rtc;
+            int8_t mux;             // index into m_mux, or -1
+            uint8_t channel;
+            time_t t;               // time from the last readAll(), zero if not read
+            bool outlier;
+            int32_t skew;           // microseconds after RTC 0, see setAll()
+        };
+        struct mux_t {
+            TwoWire* bus;
+            uint8_t addr;
+            int16_t selected;       // channel mask last written, or -1 if unknown
+        };
+
+        rtc_t m_rtc[MAX_RTCS];
+        mux_t m_mux[MAX_MUXES];
+        TwoWire* m_bus[MAX_RTCS];   // bus of each RTC
+        uint8_t m_order[MAX_RTCS];  // RTC indexes in access order
+        uint8_t m_n {0};
+        uint8_t m_nMux {0};
+        uint32_t m_tolerance;
+        time_t m_consensus {0};
+        uint8_t m_outliers {0};
+
+        bool route(const uint8_t index);
+        bool muxWrite(mux_t& m, const uint8_t mask);
+        bool before(const uint8_t a, const uint8_t b);
+};
+#endif
@@ -0,0 +1,149 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Power outage journal in SRAM, see MCP79412OutageJournal.h.
+//
+// SRAM layout, from the journal's address: 16-byte header, then a
+// ring of as many entries of two time_t values (power down, power up)
+// as fit in the rest of the SRAM, MAX_ENTRIES at address 0. The header
+// is written after the entry, so an interrupted update leaves the
+// previous header, which still describes a consistent journal.
+
+#include <MCP79412OutageJournal.h>
+
+// Read the header, initializing the journal if the SRAM does not hold
+// a valid one (e.g. first use, or the backup battery was lost), then
+// record an outage if the RTC has captured one. If an EEPROM log is
+// given (with a record size of sizeof(SPILL_t)), the oldest entries are
+// moved to it when the ring is full. Returns true if an outage was
+// recorded. If the journal's SRAM address leaves no room for the
+// header and one entry (see capacity()), the SRAM is not used and the
+// journal stays empty. If the header cannot be read (I2C error), the
+// SRAM is not touched and the journal is not loaded (see isLoaded()):
+// nothing is recorded until begin() succeeds.
+bool MCP79412OutageJournal::begin(MCP79412EepromLog* spill)
+{
+    m_spill = spill;
+    m_loaded = false;
+    if (m_entries == 0) return false;
+    if ( m_rtc.readRTC(MCP79412RTC::SRAM_START_ADDR + m_addr,
+        reinterpret_cast<uint8_t*>(&m_hdr), HEADER_SIZE) != 0 ) {
+        memset(&m_hdr, 0, sizeof(m_hdr));
+        return false;
+    }
+    if (m_hdr.magic != MAGIC || m_hdr.check != checksum(m_hdr)
+        || m_hdr.head >= m_entries || m_hdr.used > m_entries) {
+        clear();
+    }
+    m_loaded = true;
+    return check();
+}
+
+// Record an outage if the RTC has captured one since the last call.
+// The header keeps the day of the last check as the anchor for
+// powerFail(), so the power down time is exact for an outage that
+// began within a year of it; the header is written when the day
+// changes. Returns true if an outage was recorded.
+bool MCP79412OutageJournal::check()
+{
+    if (!m_loaded) return false;
+    time_t powerDown, powerUp;
+    uint16_t anchor = m_hdr.anchor[0] | m_hdr.anchor[1] << 8;
+    uint16_t last {anchor};
+    bool outage = m_rtc.powerFail(&powerDown, &powerUp, &anchor);
+    m_hdr.anchor[0] = anchor;
+    m_hdr.anchor[1] = anchor >> 8;
+    if (outage) record(powerDown, powerUp);
+    else if (anchor != last) writeHeader();
+    return outage;
+}
+
+// Add an outage to the ring and update the statistics: one entry
+// write and one header write (plus a spill to EEPROM if the ring is
+// full and a log was given). If the ring is still full, e.g. the spill
+// failed, the oldest entry is overwritten.
+void MCP79412OutageJournal::record(const time_t powerDown, const time_t powerUp)
+{
+    if (!m_loaded) return;
+    if (m_hdr.used == m_entries && m_spill) spill();
+
+    uint32_t entry[2] {static_cast<uint32_t>(powerDown), static_cast<uint32_t>(powerUp)};
+    m_rtc.sramWrite(entryAddr(m_hdr.head), reinterpret_cast<uint8_t*>(entry), ENTRY_SIZE);
+
+    uint32_t down = powerUp > powerDown ? powerUp - powerDown : 0;
+    m_hdr.total += down;
+    if (down > m_hdr.max) m_hdr.max = down;
+    if (m_hdr.count < 0xFFFF) ++m_hdr.count;
+    m_hdr.head = (m_hdr.head + 1) % m_entries;
+    if (m_hdr.used < m_entries) ++m_hdr.used;
+    writeHeader();
+}
+
+// Read one of the outages in the ring, index 0 being the newest.
+// Returns false if there is no such entry.
+bool MCP79412OutageJournal::recent(const uint8_t index, time_t& powerDown, time_t& powerUp)
+{
+    if (index >= m_hdr.used) return false;
+    uint8_t i = (m_hdr.head + m_entries - 1 - index) % m_entries;
+    uint32_t entry[2];
+    m_rtc.sramRead(entryAddr(i), reinterpret_cast<uint8_t*>(entry), ENTRY_SIZE);
+    powerDown = entry[0];
+    powerUp = entry[1];
+    return true;
+}
+
+// Empty the journal and zero the statistics. The EEPROM log, if any,
+// is not changed.
+void MCP79412OutageJournal::clear()
+{
+    memset(&m_hdr, 0, sizeof(m_hdr));
+    m_hdr.magic = MAGIC;
+    if (m_entries) {
+        m_loaded = true;
+        writeHeader();
+    }
+}
+
+void MCP79412OutageJournal::writeHeader()
+{
+    m_hdr.check = checksum(m_hdr);
+    m_rtc.sramWrite(m_addr, reinterpret_cast<uint8_t*>(&m_hdr), HEADER_SIZE);
+}
+
+// Move the oldest half of the entries (rounded up) to the EEPROM log.
+// The entries are read with one SRAM read where they are contiguous.
+// Stops at the first record the log fails to append, leaving that entry
+// and the newer ones in the ring.
+void MCP79412OutageJournal::spill()
+{
+    uint32_t entries[SPILL_BATCH][2];
+    uint8_t batch {spillBatch()};
+    uint8_t oldest = (m_hdr.head + m_entries - m_hdr.used) % m_entries;
+    uint8_t n = m_entries - oldest;
+    if (n > batch) n = batch;
+    m_rtc.sramRead(entryAddr(oldest), reinterpret_cast<uint8_t*>(entries), n * ENTRY_SIZE);
+    if (n < batch) {
+        m_rtc.sramRead(entryAddr(0), reinterpret_cast<uint8_t*>(entries[n]), (batch - n) * ENTRY_SIZE);
+    }
+    uint8_t moved {0};
+    for (uint8_t i=0; i<batch; ++i) {
+        SPILL_t s;
+        uint32_t min = entries[i][1] > entries[i][0] ? (entries[i][1] - entries[i][0]) / 60 : 0;
+        s.powerDown = entries[i][0];
+        s.minutes = min > 0xFFFF ? 0xFFFF : min;
+        if (m_spill->append(&s) != 0) break;
+        ++moved;
+    }
+    m_hdr.used -= moved;
+}
+
+// Checksum of the header, excluding the checksum byte.
+uint8_t MCP79412OutageJournal::checksum(const header_t& h)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&h);
+    uint8_t c {0};
+    for (uint8_t i=0; i<HEADER_SIZE-1; ++i) c = (c << 1 | c >> 7) + p[i];
+    return ~c;
+}
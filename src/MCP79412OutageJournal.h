@@ -0,0 +1,80 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// A journal of power outages in the RTC's battery-backed SRAM.
+// The SRAM holds a small header with running statistics (number of
+// outages, total and longest downtime) and a ring of the most recent
+// outages. Recording an outage writes one entry and the header, and
+// the statistics are read with the header alone, so nothing is
+// rescanned at startup. Optionally, when the ring is full, the oldest
+// entries are moved in a batch to an MCP79412EepromLog.
+
+#ifndef MCP79412_OUTAGE_JOURNAL_H_INCLUDED
+#define MCP79412_OUTAGE_JOURNAL_H_INCLUDED
+
+#include <MCP79412RTC.h>
+#include <MCP79412EepromLog.h>
+
+class MCP79412OutageJournal
+{
+    public:
+        static constexpr uint8_t
+            SRAM_SIZE {64},
+            HEADER_SIZE {16},
+            ENTRY_SIZE {8},
+            MAX_ENTRIES {(SRAM_SIZE - HEADER_SIZE) / ENTRY_SIZE},   // at SRAM address 0
+            SPILL_BATCH {(MAX_ENTRIES + 1) / 2},    // most entries moved to EEPROM at a time
+            MAX_SRAM_ADDR {SRAM_SIZE - HEADER_SIZE - ENTRY_SIZE},  // room for one entry
+            MAGIC {0x4F};
+
+        // an outage as moved to the EEPROM log (6 bytes)
+        struct SPILL_t {
+            uint32_t powerDown;
+            uint16_t minutes;       // duration, saturates at 65535
+        } __attribute__((packed));
+
+        MCP79412OutageJournal(MCP79412RTC& rtc, const uint8_t sramAddr=0)
+            : m_rtc{rtc}, m_addr{sramAddr},
+              m_entries{static_cast<uint8_t>(sramAddr <= MAX_SRAM_ADDR ? (SRAM_SIZE - sramAddr - HEADER_SIZE) / ENTRY_SIZE : 0)} {}
+        bool begin(MCP79412EepromLog* spill=nullptr);
+        bool check();
+        void record(const time_t powerDown, const time_t powerUp);
+        void clear();
+        uint16_t count() {return m_hdr.count;}
+        uint32_t totalDowntime() {return m_hdr.total;}
+        uint32_t maxDowntime() {return m_hdr.max;}
+        uint32_t meanDowntime() {return m_hdr.count ? m_hdr.total / m_hdr.count : 0;}
+        uint8_t recentCount() {return m_hdr.used;}
+        uint8_t capacity() {return m_entries;}
+        bool isLoaded() {return m_loaded;}
+        bool recent(const uint8_t index, time_t& powerDown, time_t& powerUp);
+
+    private:
+        struct header_t {
+            uint32_t total;         // total downtime, seconds
+            uint32_t max;           // longest outage, seconds
+            uint16_t count;         // outages recorded
+            uint8_t head;           // ring index for the next entry
+            uint8_t used;           // entries in the ring
+            uint8_t magic;
+            uint8_t anchor[2];      // day of the last check, low byte first, see powerFail()
+            uint8_t check;          // checksum of the header
+        };
+        static_assert(sizeof(header_t) == HEADER_SIZE, "journal header size");
+
+        MCP79412RTC& m_rtc;
+        uint8_t m_addr;             // SRAM address of the journal
+        uint8_t m_entries;          // entries that fit in the SRAM, zero if not even one
+        MCP79412EepromLog* m_spill {nullptr};
+        bool m_loaded {false};      // the header was read or initialized, see begin()
+        header_t m_hdr {};
+
+        uint8_t entryAddr(const uint8_t i) {return m_addr + HEADER_SIZE + i * ENTRY_SIZE;}
+        void writeHeader();
+        void spill();
+        uint8_t spillBatch() {return (m_entries + 1) / 2;}
+        static uint8_t checksum(const header_t& h);
+};
+#endif
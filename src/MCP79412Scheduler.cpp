@@ -0,0 +1,212 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Software alarm scheduler, see MCP79412Scheduler.h.
+
+#include <MCP79412Scheduler.h>
+
+// Add a one-shot alarm, due at the given time. If it is already due,
+// its handler is called before at() returns.
+// Returns the alarm's id, or NONE if there are already MAX_ALARMS.
+uint8_t MCP79412Scheduler::at(const time_t t, HANDLER_t handler)
+{
+    return add(t, 0, handler);
+}
+
+// Add a recurring alarm, due every period seconds, first at the given
+// time (optional, default one period from now).
+// Returns the alarm's id, or NONE if there are already MAX_ALARMS.
+uint8_t MCP79412Scheduler::every(const uint32_t period, HANDLER_t handler, const time_t first)
+{
+    if (period == 0) return NONE;
+    return add(first ? first : m_rtc.get() + period, period, handler);
+}
+
+// Remove an alarm. Returns false if there is no alarm with the given id.
+bool MCP79412Scheduler::cancel(const uint8_t id)
+{
+    if (id >= MAX_ALARMS || !m_handler[id]) return false;
+    bool wasNext {m_pos[id] == 0};
+    remove(m_pos[id]);
+    m_handler[id] = nullptr;
+    if (wasNext && !m_dispatching) {
+        if (m_n) dispatch(m_rtc.get());     // program the new earliest alarm
+        else enable(false);
+    }
+    return true;
+}
+
+// Check the hardware alarm's flag, a one-byte read, and if it is set,
+// call the handlers of the alarms that are due and program the next.
+// If the last attempt to program the hardware alarm failed, dispatch
+// without checking the flag, to try again.
+// There is no bus traffic if there are no alarms.
+// Returns the number of handlers called.
+uint8_t MCP79412Scheduler::poll()
+{
+    if (m_n == 0) return 0;
+    if (!m_armed) return dispatch(m_rtc.get());
+    uint8_t day {m_rtc.readRTC(MCP79412RTC::alarmRegister(m_alarm, MCP79412RTC::ALM0WKDAY))};
+    m_pol = MCP79412RTC::alarmPolarityBit(m_alarm, day);
+    if ( !(day & _BV(MCP79412RTC::ALMxIF)) ) return 0;
+    return dispatch(m_rtc.get());
+}
+
+// Call the handlers of the alarms that are due at the given time,
+// reschedule the recurring ones, and program the earliest remaining
+// alarm into the hardware alarm, which clears its flag. A recurring
+// alarm that was missed is rescheduled to its next due time after now,
+// and its handler is called once. A handler may add and cancel alarms.
+// If the next alarm is due in a second or less, the time is read again
+// after programming it, in case it was already due by then. If the
+// hardware alarm cannot be programmed, armed() is false until a later
+// poll() or dispatch() succeeds.
+// Returns the number of handlers called.
+uint8_t MCP79412Scheduler::dispatch(time_t now)
+{
+    uint8_t n {0};
+    m_dispatching = true;
+    while (true) {
+        while (m_n && m_due[m_heap[0]] <= now) {
+            uint8_t id {m_heap[0]};
+            HANDLER_t handler {m_handler[id]};
+            if (m_period[id]) {
+                time_t due = m_due[id] + m_period[id];
+                if (due <= now) due += ((now - due) / m_period[id] + 1) * m_period[id];
+                m_due[id] = due;
+                siftDown(0);
+            }
+            else {
+                remove(0);
+                m_handler[id] = nullptr;
+            }
+            handler(id);
+            ++n;
+        }
+        if (m_n == 0) {
+            if (m_enabled) enable(false);
+            break;
+        }
+        time_t due {m_due[m_heap[0]]};
+        if (program(now) != 0) break;
+        if (due - now > 1) break;
+        now = m_rtc.get();
+        if (due > now) break;
+    }
+    m_dispatching = false;
+    return n;
+}
+
+// The least specific alarm match mode that first matches at exactly
+// the due time, after now. A mode that matches only some of the fields
+// matches at the first second after now at which those fields equal
+// the due time's, so e.g. matching the minutes works for a due time on
+// a minute boundary less than an hour away, in a different minute of
+// the hour than now.
+MCP79412RTC::ALARM_TYPES_t MCP79412Scheduler::matchMode(const time_t now, const time_t due)
+{
+    uint32_t d = due - now;
+    if (d < 60) return MCP79412RTC::ALM_MATCH_SECONDS;
+    if (due % 60 == 0 && d < 3600 && (now / 60) % 60 != (due / 60) % 60) {
+        return MCP79412RTC::ALM_MATCH_MINUTES;
+    }
+    if (due % 3600 == 0 && d < 86400 && (now / 3600) % 24 != (due / 3600) % 24) {
+        return MCP79412RTC::ALM_MATCH_HOURS;
+    }
+    if (due % 86400 == 0 && d <= 6 * 86400UL) return MCP79412RTC::ALM_MATCH_DAY;
+    if (due % 86400 == 0 && d <= 27 * 86400UL) return MCP79412RTC::ALM_MATCH_DATE;
+    return MCP79412RTC::ALM_MATCH_DATETIME;
+}
+
+// Add an alarm to the heap, and reprogram the hardware alarm if it is
+// the new earliest.
+uint8_t MCP79412Scheduler::add(const time_t due, const uint32_t period, HANDLER_t handler)
+{
+    if (!handler) return NONE;
+    uint8_t id {0};
+    while (id < MAX_ALARMS && m_handler[id]) ++id;
+    if (id >= MAX_ALARMS) return NONE;
+    m_due[id] = due;
+    m_period[id] = period;
+    m_handler[id] = handler;
+    push(id);
+    if (m_pos[id] == 0 && !m_dispatching) dispatch(m_rtc.get());
+    return id;
+}
+
+void MCP79412Scheduler::push(const uint8_t id)
+{
+    place(id, m_n++);
+    siftUp(m_n - 1);
+}
+
+// Remove the alarm at the given position in the heap.
+void MCP79412Scheduler::remove(const uint8_t pos)
+{
+    if (--m_n == pos) return;
+    place(m_heap[m_n], pos);
+    siftUp(pos);
+    siftDown(m_pos[m_heap[pos]]);
+}
+
+void MCP79412Scheduler::siftUp(uint8_t pos)
+{
+    uint8_t id {m_heap[pos]};
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (m_due[m_heap[parent]] <= m_due[id]) break;
+        place(m_heap[parent], pos);
+        pos = parent;
+    }
+    place(id, pos);
+}
+
+void MCP79412Scheduler::siftDown(uint8_t pos)
+{
+    uint8_t id {m_heap[pos]};
+    while (true) {
+        uint8_t child = 2 * pos + 1;
+        if (child >= m_n) break;
+        if (child + 1 < m_n && m_due[m_heap[child + 1]] < m_due[m_heap[child]]) ++child;
+        if (m_due[id] <= m_due[m_heap[child]]) break;
+        place(m_heap[child], pos);
+        pos = child;
+    }
+    place(id, pos);
+}
+
+// Program the earliest alarm into the hardware alarm: one write of the
+// alarm registers from ALMxSEC through ALMxWKDAY, which sets the match
+// mode and clears the flag, or through ALMxDATE or ALMxMTH if the match
+// mode needs them. The first time, the ALMPOL bit is read first (so it
+// is kept), and the alarm is enabled after it is programmed.
+// Returns the I2C status (zero if successful).
+uint8_t MCP79412Scheduler::program(const time_t now)
+{
+    time_t due {m_due[m_heap[0]]};
+    m_mode = matchMode(now, due);
+    if (!m_enabled) m_pol = m_rtc.alarmPolarityBit(m_alarm);
+    uint8_t regs[tmNbrFields];
+    MCP7941xCivil::timeToRegs(due, regs);
+    regs[3] |= m_pol | m_mode << 4;     // ALMxIF == 0
+    uint8_t n {4};
+    if (m_mode == MCP79412RTC::ALM_MATCH_DATE) n = 5;
+    if (m_mode == MCP79412RTC::ALM_MATCH_DATETIME) n = 6;
+    uint8_t e {m_rtc.writeRTC(MCP79412RTC::alarmRegister(m_alarm, MCP79412RTC::ALM0SEC), regs, n)};
+    if (e == 0 && !m_enabled) e = enable(true);
+    m_armed = (e == 0);
+    return e;
+}
+
+// Enable or disable the hardware alarm.
+// Returns the I2C status (zero if successful).
+uint8_t MCP79412Scheduler::enable(const bool on)
+{
+    uint8_t e {m_rtc.setAlarmEnable(m_alarm, on)};
+    if (e) return e;
+    m_enabled = on;
+    if (!on) m_mode = MCP79412RTC::ALM_DISABLE;
+    return 0;
+}
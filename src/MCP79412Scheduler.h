@@ -0,0 +1,80 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Software alarms, any number of them (up to MAX_ALARMS) on one of the
+// RTC's two hardware alarms. The alarms are kept in a min-heap by due
+// time, and the earliest is always programmed into the hardware alarm,
+// so the MCU can sleep until the RTC's MFP wakes it. Each alarm is
+// one-shot (at()) or recurring (every()), and calls a handler when it
+// is due.
+//
+// The hardware alarm is programmed with the least specific match mode
+// that still fires at exactly the due time, e.g. matching only the
+// seconds for an alarm less than a minute away, or only the date for
+// one at midnight up to 27 days away. The alarm registers up to
+// ALMxWKDAY, and ALMxDATE and ALMxMTH only when the match needs them,
+// are written in one transfer, which also clears the alarm flag. So
+// servicing an alarm takes a read of the flag, a read of the time, and
+// one write.
+//
+// poll() checks the flag and, if it is set, calls the handlers of the
+// alarms that are due and programs the next one. dispatch() does the
+// same without checking the flag, for a caller that knows the alarm
+// fired, e.g. from the MFP interrupt. If programming the hardware alarm
+// fails, armed() is false and the next poll() or dispatch() tries
+// again; the MCU should not sleep until it succeeds. The scheduler owns
+// its hardware alarm; the other one is free for other uses.
+
+#ifndef MCP79412_SCHEDULER_H_INCLUDED
+#define MCP79412_SCHEDULER_H_INCLUDED
+
+#include <MCP79412RTC.h>
+
+class MCP79412Scheduler
+{
+    public:
+        static constexpr uint8_t
+            MAX_ALARMS {16},
+            NONE {0xFF};                // not a valid alarm id
+        typedef void (*HANDLER_t)(const uint8_t id);
+
+        MCP79412Scheduler(MCP79412RTC& rtc, const MCP79412RTC::ALARM_NBR_t alarmNumber=MCP79412RTC::ALARM_0)
+            : m_rtc{rtc}, m_alarm{alarmNumber} {}
+        uint8_t at(const time_t t, HANDLER_t handler);
+        uint8_t every(const uint32_t period, HANDLER_t handler, const time_t first=0);
+        bool cancel(const uint8_t id);
+        uint8_t count() {return m_n;}
+        time_t next() {return m_n ? m_due[m_heap[0]] : 0;}
+        uint8_t poll();
+        uint8_t dispatch(time_t now);
+        MCP79412RTC::ALARM_TYPES_t mode() {return m_mode;}
+        bool armed() {return m_armed || m_n == 0;}
+        static MCP79412RTC::ALARM_TYPES_t matchMode(const time_t now, const time_t due);
+
+    private:
+        MCP79412RTC& m_rtc;
+        MCP79412RTC::ALARM_NBR_t m_alarm;
+        time_t m_due[MAX_ALARMS];       // next due time of each alarm
+        uint32_t m_period[MAX_ALARMS];  // seconds, zero for one-shot
+        HANDLER_t m_handler[MAX_ALARMS] {}; // nullptr if the id is free
+        uint8_t m_heap[MAX_ALARMS];     // alarm ids, a min-heap by due time
+        uint8_t m_pos[MAX_ALARMS];      // position of each alarm in the heap
+        uint8_t m_n {0};                // number of alarms
+        uint8_t m_pol {0};              // ALMPOL bit, see MCP79412RTC::alarmPolarityBit()
+        bool m_enabled {false};         // hardware alarm enabled
+        bool m_armed {false};           // the earliest alarm is programmed
+        bool m_dispatching {false};     // in dispatch(), which programs at the end
+        MCP79412RTC::ALARM_TYPES_t m_mode {MCP79412RTC::ALM_DISABLE};
+
+        uint8_t add(const time_t due, const uint32_t period, HANDLER_t handler);
+        void push(const uint8_t id);
+        void remove(const uint8_t pos);
+        void siftUp(uint8_t pos);
+        void siftDown(uint8_t pos);
+        void place(const uint8_t id, const uint8_t pos) {m_heap[pos] = id; m_pos[id] = pos;}
+        uint8_t program(const time_t now);
+        uint8_t enable(const bool on);
+};
+#endif
@@ -0,0 +1,107 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Bus statistics, see MCP79412Stats.h.
+
+#include <MCP79412Stats.h>
+
+// operation names for report(), in the order of OP_t
+static const char opNames[MCP79412Stats::OP_COUNT][13] PROGMEM {
+    "get", "set", "read", "sramRead", "sramWrite", "eepromRead", "eepromWrite",
+    "alarm", "calib", "control", "id", "powerFail", "register", "other"
+};
+
+// Zero all of the statistics.
+void MCP79412Stats::reset()
+{
+    memset(m_ops, 0, sizeof(m_ops));
+    for (uint8_t i=0; i<OP_COUNT; ++i) m_ops[i].minMicros = UINT32_MAX;
+    memset(m_errors, 0, sizeof(m_errors));
+    m_eepromPolls = 0;
+    m_eepromRetries = 0;
+    m_current = OP_COUNT;
+}
+
+// Count an I2C transfer for the current operation, and its error, if any.
+void MCP79412Stats::transfer(const uint8_t bytesWritten, const uint8_t bytesRead, const uint8_t status)
+{
+    OP_STATS_t& s = m_ops[current()];
+    ++s.transfers;
+    s.bytesWritten += bytesWritten;
+    s.bytesRead += bytesRead;
+    if (status > 0 && status < ERR_CODES) ++m_errors[status];
+}
+
+// Start an operation. The caller keeps the start time.
+void MCP79412Stats::begin(const OP_t op, uint32_t& startMicros)
+{
+    m_current = op;
+    ++m_ops[op].calls;
+    startMicros = micros();
+}
+
+// End the current operation and record its latency.
+void MCP79412Stats::end(const uint32_t startMicros)
+{
+    uint32_t us = micros() - startMicros;
+    OP_STATS_t& s = m_ops[current()];
+    if (us < s.minMicros) s.minMicros = us;
+    if (us > s.maxMicros) s.maxMicros = us;
+    s.totalMicros += us;
+    uint8_t b {0};
+    for (uint32_t limit = 1UL << HIST_SHIFT; b < HIST_BUCKETS - 1 && us >= limit; limit <<= 1) ++b;
+    if (s.hist[b] < UINT16_MAX) ++s.hist[b];
+    m_current = OP_COUNT;
+}
+
+// Print the statistics: one line for each operation that was used,
+// with its calls, transfers, bytes written and read, the minimum,
+// average and maximum latency in microseconds and the latency
+// histogram, then the error counts.
+void MCP79412Stats::report(Print& p) const
+{
+    p.print(F("op           calls  xfers  wrote   read  min_us  avg_us  max_us  hist <256us..>=16ms\n"));
+    for (uint8_t i=0; i<OP_COUNT; ++i) {
+        const OP_STATS_t& s = m_ops[i];
+        if (s.calls == 0 && s.transfers == 0) continue;
+        uint8_t n = p.print(reinterpret_cast<const __FlashStringHelper*>(opNames[i]));
+        while (n++ < 11) p.print(' ');
+        const uint32_t cols[] {s.calls, s.transfers, s.bytesWritten, s.bytesRead,
+            s.calls ? s.minMicros : 0, avgMicros(static_cast<OP_t>(i)), s.maxMicros};
+        for (uint8_t c=0; c<7; ++c) {
+            uint32_t v {cols[c]};
+            uint8_t width = c < 4 ? 7 : 8;
+            uint8_t digits {1};
+            while (v >= 10) {
+                v /= 10;
+                ++digits;
+            }
+            while (digits++ < width) p.print(' ');
+            p.print(cols[c]);
+        }
+        p.print(F("  "));
+        for (uint8_t b=0; b<HIST_BUCKETS; ++b) {
+            p.print(' ');
+            p.print(s.hist[b]);
+        }
+        p.println();
+    }
+    p.print(F("errors: nack addr "));
+    p.print(m_errors[2]);
+    p.print(F(", nack data "));
+    p.print(m_errors[3]);
+    p.print(F(", too long "));
+    p.print(m_errors[1]);
+    p.print(F(", other "));
+    p.print(m_errors[4]);
+    p.print(F(", timeout "));
+    p.print(m_errors[5]);
+    p.print(F(", short read "));
+    p.println(m_errors[0]);
+    p.print(F("eeprom: polls "));
+    p.print(m_eepromPolls);
+    p.print(F(", write retries "));
+    p.println(m_eepromRetries);
+}
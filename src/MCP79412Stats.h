@@ -0,0 +1,149 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Bus statistics, for finding out what the library costs on the bus.
+// Compiled only if MCP79412_STATS is defined (e.g. with a build flag,
+// -DMCP79412_STATS), otherwise the library is exactly as without it.
+// When enabled, each RTC object counts, for each kind of operation
+// (see OP_t), the calls, I2C transfers and bytes, and the call latency
+// (minimum, average, maximum and a histogram); and, for all operations,
+// the I2C errors by status code, the EEPROM acknowledge polls and the
+// EEPROM write retries. A function that calls another (e.g. set()
+// calling writeRTC()) counts as one call of the outer function. The
+// statistics take about 600 bytes of RAM per RTC.
+//
+// The counting is done by MCP79412CountingTransport, which wraps the
+// RTC's I2C transport (see MCP7941xTransport.h), and by a
+// MCP79412StatsScope at the start of each library function. The
+// statistics are updated with the bus lock held, if there is one (see
+// MCP79412RTC::setBusLock()), so latencies exclude waiting for the lock.
+
+#ifndef MCP79412_STATS_H_INCLUDED
+#define MCP79412_STATS_H_INCLUDED
+
+#include <Arduino.h>
+#include <MCP79412BusLock.h>
+
+class MCP79412Stats
+{
+    public:
+        enum OP_t {
+            OP_GET,             // get()
+            OP_SET,             // set(), write(), setPrecise(), calibratePreciseLatency()
+            OP_READ,            // read(), snapshot()
+            OP_SRAM_READ,       // sramRead()
+            OP_SRAM_WRITE,      // sramWrite()
+            OP_EEPROM_READ,     // eepromRead(), eepromReadBulk()
+            OP_EEPROM_WRITE,    // eepromWrite(), eepromWriteBulk(), eepromWritePage(), eepromReady()
+            OP_ALARM,           // setAlarm(), enableAlarm(), alarm(), alarmPolarity(), clearAlarmFlags()
+            OP_CALIB,           // calibRead(), calibWrite(), coarseTrim()
+            OP_CONTROL,         // squareWave(), out(), vbaten(), isRunning(), shadowRegisters()
+            OP_ID,              // idRead(), getEUI64()
+            OP_POWER_FAIL,      // powerFail()
+            OP_REGISTER,        // readRTC(), writeRTC()
+            OP_OTHER,           // transfers outside of a library function, e.g. begin()
+            OP_COUNT
+        };
+        static constexpr uint8_t HIST_BUCKETS {8};  // <256us, <512us, ... <16384us, >=16384us
+        static constexpr uint8_t HIST_SHIFT {8};    // the first bucket is below 1 << HIST_SHIFT us
+        static constexpr uint8_t ERR_CODES {6};     // status 1-5, and short reads (index 0)
+
+        struct OP_STATS_t {
+            uint32_t calls;
+            uint32_t transfers;         // I2C transfers (address phases), including NACKed ones
+            uint32_t bytesWritten;      // data bytes of successful transfers, excluding address bytes
+            uint32_t bytesRead;
+            uint32_t minMicros;
+            uint32_t maxMicros;
+            uint32_t totalMicros;
+            uint16_t hist[HIST_BUCKETS];    // calls by latency, saturating
+        };
+
+        MCP79412Stats() {reset();}
+        void reset();
+        const OP_STATS_t& op(const OP_t op) const {return m_ops[op];}
+        uint32_t avgMicros(const OP_t op) const
+            {return m_ops[op].calls ? m_ops[op].totalMicros / m_ops[op].calls : 0;}
+        // I2C errors with the given status (1-5); errors(0) is the
+        // number of reads that returned fewer bytes than requested.
+        uint32_t errors(const uint8_t status) const {return status < ERR_CODES ? m_errors[status] : 0;}
+        uint32_t eepromPolls() const {return m_eepromPolls;}
+        uint32_t eepromRetries() const {return m_eepromRetries;}
+        void report(Print& p) const;
+
+        // used by the library
+        void transfer(const uint8_t bytesWritten, const uint8_t bytesRead, const uint8_t status);
+        void shortRead() {++m_errors[0];}
+        void eepromPoll(const uint8_t polls) {m_eepromPolls += polls;}
+        void eepromRetry() {++m_eepromRetries;}
+        void begin(const OP_t op, uint32_t& startMicros);
+        void end(const uint32_t startMicros);
+        bool active() const {return m_current != OP_COUNT;}
+
+    private:
+        OP_STATS_t m_ops[OP_COUNT];
+        uint32_t m_errors[ERR_CODES];
+        uint32_t m_eepromPolls;
+        uint32_t m_eepromRetries;
+        OP_t m_current;             // operation in progress, OP_COUNT if none
+        OP_t current() const {return m_current == OP_COUNT ? OP_OTHER : m_current;}
+};
+
+// Counts a library function's call and latency, for the life of the
+// scope. Nested scopes (a library function calling another) count only
+// as the outermost.
+class MCP79412StatsScope
+{
+    public:
+        MCP79412StatsScope(MCP79412Stats& stats, const MCP79412Stats::OP_t op)
+            : m_stats(stats), m_outer{!stats.active()} {if (m_outer) m_stats.begin(op, m_start);}
+        ~MCP79412StatsScope() {if (m_outer) m_stats.end(m_start);}
+        MCP79412StatsScope(const MCP79412StatsScope&) = delete;
+        MCP79412StatsScope& operator=(const MCP79412StatsScope&) = delete;
+
+    private:
+        MCP79412Stats& m_stats;
+        bool m_outer;
+        uint32_t m_start;
+};
+
+// An I2C transport that counts the transfers made through another.
+template <class Transport>
+class MCP79412CountingTransport : public Transport
+{
+    public:
+        MCP79412CountingTransport(const Transport& t) : Transport(t) {}
+        void beginTransmission(const uint8_t addr) {m_txLen = 0; Transport::beginTransmission(addr);}
+        void write(const uint8_t b) {++m_txLen; Transport::write(b);}
+        uint8_t endTransmission(const bool sendStop=true)
+        {
+            uint8_t e = Transport::endTransmission(sendStop);
+            m_stats.transfer(e == 0 ? m_txLen : 0, 0, e);
+            return e;
+        }
+        uint8_t requestFrom(const uint8_t addr, const uint8_t n)
+        {
+            uint8_t got = Transport::requestFrom(addr, n);
+            m_stats.transfer(0, got, 0);
+            if (got < n) m_stats.shortRead();
+            return got;
+        }
+        MCP79412Stats& stats() {return m_stats;}
+
+    private:
+        MCP79412Stats m_stats;
+        uint8_t m_txLen {0};
+};
+
+#ifdef MCP79412_STATS
+// used in MCP7941x functions; the bus lock (if any) protects the statistics
+#define MCP79412_STATS_SCOPE(op) MCP79412BusGuard statsGuard(busLock); \
+    MCP79412StatsScope statsScope(bus.stats(), MCP79412Stats::op)
+#define MCP79412_STATS_COUNT(x) bus.stats().x
+#else
+#define MCP79412_STATS_SCOPE(op)
+#define MCP79412_STATS_COUNT(x)
+#endif
+#endif
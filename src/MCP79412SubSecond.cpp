@@ -0,0 +1,151 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Sub-second timestamps from the square wave, see MCP79412SubSecond.h.
+
+#include <MCP79412SubSecond.h>
+
+MCP79412SubSecond* MCP79412SubSecond::s_instance {nullptr};
+
+// Start the square wave at the given frequency on the MFP, which must
+// be connected to the given interrupt-capable pin, and lock to the
+// RTC's seconds. At 1Hz both edges are counted, at the higher
+// frequencies only falling edges. Takes up to about two seconds.
+// Returns false if the RTC is not running or no edges were seen; the
+// interrupt is then detached and the square wave turned off.
+bool MCP79412SubSecond::begin(const uint8_t pin, const MCP79412RTC::SQWAVE_FREQS_t freq)
+{
+    static constexpr uint32_t hz[] {1, 4096, 8192, 32768};
+    if (freq >= MCP79412RTC::SQWAVE_NONE) return false;
+    end();
+
+    m_pin = pin;
+    uint32_t eps = (freq == MCP79412RTC::SQWAVE_1_HZ) ? 2 : hz[freq];
+    m_periodUs = 1000000 / eps;
+    noInterrupts();
+    m_eps = 0xFFFFFFFF;         // count without wrapping while locking
+    m_edge = 0;
+    interrupts();
+    s_instance = this;
+    pinMode(pin, INPUT_PULLUP);     // the MFP is open drain
+    m_rtc.squareWave(freq);
+    attachInterrupt(digitalPinToInterrupt(pin), isr,
+        freq == MCP79412RTC::SQWAVE_1_HZ ? CHANGE : FALLING);
+    if (lock(eps)) return true;
+    end();
+    return false;
+}
+
+// Lock the edge count to the RTC's seconds, counting eps edges a
+// second. Returns false if the RTC is not running or no edges were
+// seen.
+bool MCP79412SubSecond::lock(const uint32_t eps)
+{
+    // find the rollover to within the coarse step, then find the next
+    // one to within the time of one read.
+    time_t t;
+    uint32_t us;
+    if ( !findRollover(COARSE_STEP_MS, LOCK_TIMEOUT_MS, t, us) ) return false;
+    while (micros() - us < 1000000UL - 2000UL * COARSE_STEP_MS) delay(1);
+    if ( !findRollover(0, 4 * COARSE_STEP_MS, t, us) ) return false;
+
+    // the edge nearest the rollover starts the second
+    noInterrupts();
+    uint32_t count = m_edge;
+    uint32_t usEdge = m_edgeMicros;
+    interrupts();
+    if (count == 0) return false;
+    float n = static_cast<int32_t>(usEdge - us) / (1000000.0 / eps);
+    int32_t since = static_cast<int32_t>(n < 0 ? n - 0.5 : n + 0.5);   // edges since the rollover
+
+    noInterrupts();
+    since += m_edge - count;
+    if (since < 0) {
+        m_sec = t - 1;
+        m_edge = eps + since;
+    }
+    else {
+        m_sec = t + since / eps;
+        m_edge = since % eps;
+    }
+    m_eps = eps;
+    interrupts();
+    m_locked = true;
+    return true;
+}
+
+// Stop counting and turn off the square wave.
+void MCP79412SubSecond::end()
+{
+    if (s_instance != this) return;
+    detachInterrupt(digitalPinToInterrupt(m_pin));
+    m_rtc.squareWave(MCP79412RTC::SQWAVE_NONE);
+    s_instance = nullptr;
+    m_locked = false;
+}
+
+// Microseconds since 00:00:00 1 Jan 1970 by the RTC, or zero if not
+// locked. The resolution is that of micros(); the time within one
+// edge period is measured by the MCU's clock.
+uint64_t MCP79412SubSecond::nowMicros()
+{
+    if (!m_locked) return 0;
+    noInterrupts();
+    time_t sec = m_sec;
+    uint32_t edge = m_edge;
+    uint32_t usEdge = m_edgeMicros;
+    interrupts();
+    uint32_t frac = micros() - usEdge;
+    if (frac >= m_periodUs) frac = m_periodUs - 1;
+    return static_cast<uint64_t>(sec) * 1000000 + static_cast<uint64_t>(edge) * 1000000 / m_eps + frac;
+}
+
+// The current second, or zero if not locked.
+time_t MCP79412SubSecond::now()
+{
+    if (!m_locked) return 0;
+    noInterrupts();
+    time_t sec = m_sec;
+    interrupts();
+    return sec;
+}
+
+// Read the time, then the seconds register every stepMs until it
+// changes. Returns the new second and the micros() halfway between the
+// last two reads, or false on timeout.
+bool MCP79412SubSecond::findRollover(const uint16_t stepMs, const uint16_t timeoutMs, time_t& t, uint32_t& us)
+{
+    uint32_t msStart = millis();
+    uint32_t usPrev = micros();
+    t = m_rtc.get();
+    if (t == 0) return false;
+    uint8_t last = t % 60;
+    while (millis() - msStart < timeoutMs) {
+        if (stepMs) delay(stepMs);
+        uint32_t usRead = micros();
+        uint8_t s = m_rtc.readRTC(MCP79412RTC::RTCSEC) & 0x7F;
+        uint32_t usDone = micros();
+        uint8_t sec = (s >> 4) * 10 + (s & 0x0F);
+        if (sec != last) {
+            if (sec != (last + 1) % 60) return false;
+            ++t;
+            us = usPrev + (usDone - usPrev) / 2;
+            return true;
+        }
+        usPrev = usRead;
+    }
+    return false;
+}
+
+// Count an edge of the square wave.
+void MCP79412_ISR_ATTR MCP79412SubSecond::isr()
+{
+    MCP79412SubSecond* p = s_instance;
+    p->m_edgeMicros = micros();
+    if (++p->m_edge >= p->m_eps) {
+        p->m_edge = 0;
+        p->m_sec = p->m_sec + 1;
+    }
+}
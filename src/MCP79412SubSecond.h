@@ -0,0 +1,48 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Sub-second timestamps from the RTC's square wave output.
+// The MFP is connected to an interrupt pin and an ISR counts the square
+// wave edges. begin() finds the RTC's seconds rollover and the edge
+// that coincides with it; from then on, the time is the second plus
+// the edges counted since, plus micros() since the last edge. Reading
+// the time never uses the I2C bus. Only one instance can be active.
+
+#ifndef MCP79412_SUBSECOND_H_INCLUDED
+#define MCP79412_SUBSECOND_H_INCLUDED
+
+#include <MCP79412RTC.h>
+
+class MCP79412SubSecond
+{
+    public:
+        static constexpr uint16_t
+            LOCK_TIMEOUT_MS {1100},     // max time to wait for a seconds rollover
+            COARSE_STEP_MS {20};        // seconds register poll interval while locking
+
+        MCP79412SubSecond(MCP79412RTC& rtc) : m_rtc{rtc} {}
+        bool begin(const uint8_t pin, const MCP79412RTC::SQWAVE_FREQS_t freq=MCP79412RTC::SQWAVE_1_HZ);
+        void end();
+        bool isLocked() {return m_locked;}
+        uint64_t nowMicros();
+        uint64_t nowMillis() {return nowMicros() / 1000;}
+        time_t now();
+
+    private:
+        MCP79412RTC& m_rtc;
+        uint8_t m_pin;
+        bool m_locked {false};
+        uint32_t m_periodUs;                // time between counted edges
+        volatile time_t m_sec;              // current second
+        volatile uint32_t m_edge;           // edges counted in the current second
+        volatile uint32_t m_edgeMicros;     // micros() at the last edge
+        volatile uint32_t m_eps;            // edges per second
+
+        static MCP79412SubSecond* s_instance;
+        static void isr();
+        bool lock(const uint32_t eps);
+        bool findRollover(const uint16_t stepMs, const uint16_t timeoutMs, time_t& t, uint32_t& us);
+};
+#endif
@@ -0,0 +1,217 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Batched register updates, see MCP79412Transaction.h.
+
+#include <MCP79412Transaction.h>
+
+using RTC_t = MCP79412RTC;
+
+// Set a register to the given value. Addresses past 0x1F are ignored.
+MCP79412Transaction& MCP79412Transaction::write(const uint8_t addr, const uint8_t value)
+{
+    return modify(addr, 0xFF, value);
+}
+
+// Set consecutive registers to the given values.
+MCP79412Transaction& MCP79412Transaction::write(const uint8_t addr, const uint8_t* values, const uint8_t nBytes)
+{
+    for (uint8_t i=0; i<nBytes; ++i) modify(addr + i, 0xFF, values[i]);
+    return *this;
+}
+
+// Set the bits of a register that are ones in mask to the
+// corresponding bits of bits. The other bits keep their current values,
+// which commit() reads from the RTC. Later changes to the same bits
+// replace earlier ones.
+MCP79412Transaction& MCP79412Transaction::modify(const uint8_t addr, const uint8_t mask, const uint8_t bits)
+{
+    if (addr < REG_COUNT) {
+        m_value[addr] = (m_value[addr] & ~mask) | (bits & mask);
+        m_mask[addr] |= mask;
+    }
+    return *this;
+}
+
+// Set the time, as MCP79412RTC::set() does: the time registers are
+// written with the oscillator stopped, and the seconds register,
+// which starts it, is written last.
+MCP79412Transaction& MCP79412Transaction::set(const time_t t)
+{
+    uint8_t regs[tmNbrFields];
+    MCP7941xCivil::timeToRegs(t, regs);     // 24 hour format
+    m_seconds = regs[0] | _BV(RTC_t::STOSC);
+    regs[0] = 0x00;                         // stops the oscillator (STOSC == 0)
+    regs[3] |= _BV(RTC_t::VBATEN);          // enable battery backup
+    write(RTC_t::RTCSEC, regs, sizeof(regs));
+    m_startOsc = true;
+    return *this;
+}
+
+// Set the calibration register, see MCP79412RTC::calibWrite().
+MCP79412Transaction& MCP79412Transaction::calibWrite(const int16_t value)
+{
+    if (value >= -127 && value <= 127) {
+        write(RTC_t::OSCTRIM, value < 0 ? -value + 128 : value);
+    }
+    return *this;
+}
+
+MCP79412Transaction& MCP79412Transaction::coarseTrim(const bool enable)
+{
+    return modify(RTC_t::CONTROL, _BV(RTC_t::CRSTRIM), enable ? 0xFF : 0);
+}
+
+MCP79412Transaction& MCP79412Transaction::squareWave(const RTC_t::SQWAVE_FREQS_t freq)
+{
+    if (freq > 3) {
+        return modify(RTC_t::CONTROL, _BV(RTC_t::SQWEN), 0);
+    }
+    else {
+        return modify(RTC_t::CONTROL, _BV(RTC_t::SQWEN) | 0x03, _BV(RTC_t::SQWEN) | freq);
+    }
+}
+
+MCP79412Transaction& MCP79412Transaction::out(const bool level)
+{
+    return modify(RTC_t::CONTROL, _BV(RTC_t::OUT), level ? 0xFF : 0);
+}
+
+// Set an alarm's time, see MCP79412RTC::setAlarm().
+MCP79412Transaction& MCP79412Transaction::setAlarm(const RTC_t::ALARM_NBR_t alarmNumber, const time_t alarmTime)
+{
+    uint8_t regs[tmNbrFields];
+    MCP7941xCivil::timeToRegs(alarmTime, regs);     // 24 hour format
+    uint8_t a {static_cast<uint8_t>(RTC_t::ALM0SEC + alarmNumber * (RTC_t::ALM1SEC - RTC_t::ALM0SEC))};
+    write(a, regs, 3);
+    modify(a + 3, 0x07, regs[3]);           // keep the configuration bits
+    write(a + 4, regs + 4, 2);
+    return *this;
+}
+
+// Enable or disable an alarm, see MCP79412RTC::enableAlarm().
+// Enabling an alarm clears its interrupt flag.
+MCP79412Transaction& MCP79412Transaction::enableAlarm(const RTC_t::ALARM_NBR_t alarmNumber,
+    const RTC_t::ALARM_TYPES_t alarmType)
+{
+    if (alarmType < RTC_t::ALM_DISABLE) {
+        modify(almDay(alarmNumber), 0x78, alarmType << 4);     // mask bits, and clear ALMxIF
+        modify(RTC_t::CONTROL, _BV(RTC_t::ALM0EN + alarmNumber), 0xFF);
+    }
+    else {
+        modify(RTC_t::CONTROL, _BV(RTC_t::ALM0EN + alarmNumber), 0);
+    }
+    return *this;
+}
+
+MCP79412Transaction& MCP79412Transaction::alarmPolarity(const bool polarity)
+{
+    return modify(RTC_t::ALM0WKDAY, _BV(RTC_t::ALMPOL), polarity ? 0xFF : 0);
+}
+
+MCP79412Transaction& MCP79412Transaction::vbaten(const bool enable)
+{
+    return modify(RTC_t::RTCWKDAY, _BV(RTC_t::VBATEN), enable ? 0xFF : 0);
+}
+
+// Apply the changes to the RTC and clear the transaction.
+// If any register is only partly changed, the registers from the first
+// such to the last are read in one burst read. Then each run of
+// contiguous changed registers is written in one burst write. Two runs
+// separated only by configuration registers that were read are joined,
+// the registers between being written back unchanged. An alarm flag
+// that is not being changed is written as a one, which leaves it as it
+// is. Finally, if set() was called, the seconds register is written
+// to start the oscillator.
+// The RTC's bus lock, if any, is held for the whole commit.
+// Returns the I2C status (zero if successful); the first error stops
+// the commit.
+uint8_t MCP79412Transaction::commit()
+{
+    MCP79412BusGuard guard(m_rtc.getBusLock());
+    uint8_t e {0};
+    m_transfers = 0;
+
+    // read the registers needed for partial changes
+    uint8_t lo {REG_COUNT}, hi {0};
+    for (uint8_t a=0; a<REG_COUNT; ++a) {
+        if (m_mask[a] != 0 && m_mask[a] != 0xFF) {
+            if (lo == REG_COUNT) lo = a;
+            hi = a;
+        }
+    }
+    bool haveRead {lo < REG_COUNT};
+    if (haveRead) {
+        uint8_t cur[REG_COUNT];
+        ++m_transfers;
+        e = m_rtc.readRTC(lo, cur + lo, hi - lo + 1);
+        if (e == 0) {
+            for (uint8_t a=lo; a<=hi; ++a) {
+                uint8_t v = (cur[a] & ~m_mask[a]) | (m_value[a] & m_mask[a]);
+                if ( (a == RTC_t::ALM0WKDAY || a == RTC_t::ALM1WKDAY)
+                    && !(m_mask[a] & _BV(RTC_t::ALMxIF)) ) v |= _BV(RTC_t::ALMxIF);
+                m_value[a] = v;
+            }
+        }
+    }
+
+    // write the runs of changed registers
+    uint8_t a {0};
+    while (e == 0 && a < REG_COUNT) {
+        if (m_mask[a] == 0) {
+            ++a;
+            continue;
+        }
+        uint8_t start {a};
+        uint8_t end {a};    // one past the last changed register in the run
+        while (a < REG_COUNT) {
+            if (m_mask[a] != 0) {
+                end = ++a;
+            }
+            else if (haveRead && a > lo && a < hi && bridgeable(a)) {
+                ++a;        // may join the next run
+            }
+            else {
+                break;
+            }
+        }
+        ++m_transfers;
+        e = m_rtc.writeRTC(start, m_value + start, end - start);
+        a = end;
+    }
+
+    if (e == 0 && m_startOsc) {
+        ++m_transfers;
+        e = m_rtc.writeRTC(RTC_t::RTCSEC, m_seconds);
+    }
+    clear();
+    return e;
+}
+
+// Discard the changes.
+void MCP79412Transaction::clear()
+{
+    memset(m_mask, 0, sizeof(m_mask));
+    memset(m_value, 0, sizeof(m_value));
+    m_startOsc = false;
+}
+
+// Returns true if there are no changes to commit.
+bool MCP79412Transaction::isEmpty()
+{
+    for (uint8_t a=0; a<REG_COUNT; ++a) {
+        if (m_mask[a]) return false;
+    }
+    return true;
+}
+
+// Registers that can safely be written back with the value just read:
+// the control, calibration and alarm registers, but not the time and
+// timestamp registers (which change on their own) or EEUNLOCK.
+bool MCP79412Transaction::bridgeable(const uint8_t addr)
+{
+    return addr == RTC_t::CONTROL || addr == RTC_t::OSCTRIM
+        || (addr >= RTC_t::ALM0SEC && addr <= RTC_t::ALM1SEC + 5);
+}
@@ -0,0 +1,62 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Batched register updates for the MCP7941x.
+// A transaction collects changes to the RTC's registers (0x00-0x1F),
+// either whole bytes or bit fields, and commit() applies them all with
+// as few I2C transfers as possible: one burst read, if any bit fields
+// need the registers' current values, then one burst write per run of
+// contiguous registers. For example, setting the time, the calibration
+// and the square wave output is one read and two writes, rather than
+// five separate transfers (or more) with the MCP79412RTC functions.
+//
+// Example:
+//     MCP79412Transaction tx(myRTC);
+//     uint8_t e = tx.setAlarm(MCP79412RTC::ALARM_0, t)
+//         .enableAlarm(MCP79412RTC::ALARM_0, MCP79412RTC::ALM_MATCH_DATETIME)
+//         .commit();
+
+#ifndef MCP79412_TRANSACTION_H_INCLUDED
+#define MCP79412_TRANSACTION_H_INCLUDED
+
+#include <MCP79412RTC.h>
+
+class MCP79412Transaction
+{
+    public:
+        static constexpr uint8_t REG_COUNT {MCP79412RTC::SRAM_START_ADDR};  // registers 0x00-0x1F
+
+        MCP79412Transaction(MCP79412RTC& rtc) : m_rtc{rtc} {clear();}
+        MCP79412Transaction& write(const uint8_t addr, const uint8_t value);
+        MCP79412Transaction& write(const uint8_t addr, const uint8_t* values, const uint8_t nBytes);
+        MCP79412Transaction& modify(const uint8_t addr, const uint8_t mask, const uint8_t bits);
+        MCP79412Transaction& set(const time_t t);
+        MCP79412Transaction& calibWrite(const int16_t value);
+        MCP79412Transaction& coarseTrim(const bool enable);
+        MCP79412Transaction& squareWave(const MCP79412RTC::SQWAVE_FREQS_t freq);
+        MCP79412Transaction& out(const bool level);
+        MCP79412Transaction& setAlarm(const MCP79412RTC::ALARM_NBR_t alarmNumber, const time_t alarmTime);
+        MCP79412Transaction& enableAlarm(const MCP79412RTC::ALARM_NBR_t alarmNumber,
+            const MCP79412RTC::ALARM_TYPES_t alarmType);
+        MCP79412Transaction& alarmPolarity(const bool polarity);
+        MCP79412Transaction& vbaten(const bool enable);
+        uint8_t commit();
+        void clear();
+        bool isEmpty();
+        uint8_t transfers() {return m_transfers;}
+
+    private:
+        MCP79412RTC& m_rtc;
+        uint8_t m_value[REG_COUNT];     // new register values
+        uint8_t m_mask[REG_COUNT];      // bits changed by the transaction
+        uint8_t m_seconds;              // RTCSEC to write last, see set()
+        bool m_startOsc;                // set() was called
+        uint8_t m_transfers {0};        // I2C transfers made by the last commit()
+
+        static uint8_t almDay(const MCP79412RTC::ALARM_NBR_t n)
+            {return MCP79412RTC::ALM0WKDAY + n * (MCP79412RTC::ALM1SEC - MCP79412RTC::ALM0SEC);}
+        static bool bridgeable(const uint8_t addr);
+};
+#endif
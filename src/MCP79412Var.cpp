@@ -0,0 +1,56 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Typed SRAM and EEPROM variables, see MCP79412Var.h.
+
+#include <MCP79412Var.h>
+
+// Read nBytes at addr in SRAM or EEPROM into the cache.
+// Returns the I2C status (zero if successful).
+uint8_t RtcVarBase::load(MCP79412RTC& rtc, const MEMORY_t mem, const uint8_t addr,
+    uint8_t* cache, const uint8_t nBytes)
+{
+    if (mem == MEM_SRAM) {
+        return rtc.readRTC(MCP79412RTC::SRAM_START_ADDR + addr, cache, nBytes);
+    }
+    else {
+        return rtc.eepromReadBulk(addr, cache, nBytes);
+    }
+}
+
+// Write the bytes of value that differ from the cache, and update the
+// cache with the bytes written. SRAM gets one write, from the first
+// changed byte to the last. EEPROM gets one write per page with changed
+// bytes, again from the first changed byte on the page to the last, so
+// a page that has not changed is not written (and not worn).
+// Returns the I2C status (zero if successful).
+uint8_t RtcVarBase::store(MCP79412RTC& rtc, const MEMORY_t mem, const uint8_t addr,
+    uint8_t* cache, const uint8_t* value, const uint8_t nBytes)
+{
+    constexpr uint8_t pageMask {MCP79412RTC::EEPROM_PAGE_SIZE - 1};
+    uint8_t i {0};
+    while (i < nBytes) {
+        while (i < nBytes && cache[i] == value[i]) ++i;     // first changed byte
+        if (i == nBytes) break;
+        uint8_t first {i};
+        uint8_t last {i};
+        // for EEPROM, stop at the end of the page
+        uint8_t end {nBytes};
+        if (mem == MEM_EEPROM) {
+            uint8_t pageEnd = ((addr + i) | pageMask) + 1 - addr;
+            if (pageEnd < end) end = pageEnd;
+        }
+        for (++i; i < end; ++i) {
+            if (cache[i] != value[i]) last = i;
+        }
+        uint8_t n = last - first + 1;
+        uint8_t e = (mem == MEM_SRAM)
+            ? rtc.writeRTC(MCP79412RTC::SRAM_START_ADDR + addr + first, value + first, n)
+            : rtc.eepromWriteBulk(addr + first, value + first, n);
+        if (e) return e;
+        memcpy(cache + first, value + first, n);
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Typed variables in the RTC's SRAM and EEPROM.
+// RtcSramVar<T, Offset> and RtcEepromVar<T, Offset> hold a value of
+// type T at a fixed address, checked at compile time to fit in the
+// SRAM or EEPROM. Each keeps a copy of the stored value, so a store
+// writes only what has changed: the range from the first changed byte
+// to the last for SRAM, and only the changed pages for EEPROM (one
+// write cycle per page). Storing an unchanged value costs nothing.
+// RtcLayout<Vars...> checks at compile time that a set of variables
+// do not overlap. T must be a plain type that can be copied bytewise
+// (no pointers or virtual functions).
+//
+// Example:
+//     using BootCount = RtcSramVar<uint32_t, 0>;
+//     using Config = RtcEepromVar<config_t, 16>;
+//     static_assert(RtcLayout<BootCount, Config>::valid, "overlap");
+//     BootCount bootCount(myRTC);
+//     ...
+//     bootCount = bootCount.load() + 1;
+
+#ifndef MCP79412_VAR_H_INCLUDED
+#define MCP79412_VAR_H_INCLUDED
+
+#include <MCP79412RTC.h>
+
+// code shared by all variables of a kind, so that it is not
+// duplicated for each type.
+class RtcVarBase
+{
+    public:
+        enum MEMORY_t {MEM_SRAM, MEM_EEPROM};
+
+    protected:
+        static uint8_t load(MCP79412RTC& rtc, const MEMORY_t mem, const uint8_t addr,
+            uint8_t* cache, const uint8_t nBytes);
+        static uint8_t store(MCP79412RTC& rtc, const MEMORY_t mem, const uint8_t addr,
+            uint8_t* cache, const uint8_t* value, const uint8_t nBytes);
+};
+
+template <typename T, uint8_t Offset, RtcVarBase::MEMORY_t Mem, uint8_t MemSize>
+class RtcVar : public RtcVarBase
+{
+    public:
+        static constexpr MEMORY_t MEMORY {Mem};
+        static constexpr uint8_t
+            OFFSET {Offset},
+            SIZE {sizeof(T)},
+            END {Offset + sizeof(T)};   // one past the last byte
+        static_assert(sizeof(T) <= MemSize && Offset + sizeof(T) <= MemSize,
+            "variable does not fit in the RTC memory");
+
+        RtcVar(MCP79412RTC& rtc) : m_rtc{rtc} {}
+
+        // Read the value from the RTC. Returns the value read, or the
+        // cached value if the read failed.
+        const T& load()
+        {
+            if (RtcVarBase::load(m_rtc, Mem, Offset, bytes(), SIZE) == 0) m_valid = true;
+            return m_value;
+        }
+
+        // The value last loaded or stored; loaded first if need be.
+        const T& get()
+        {
+            if (!m_valid) load();
+            return m_value;
+        }
+        operator const T&() {return get();}
+
+        // Write the value, or just the bytes of it that differ from the
+        // stored value. Returns the I2C status (zero if successful).
+        uint8_t store(const T& value)
+        {
+            if (!m_valid) load();
+            if (!m_valid) return 4;     // cannot tell what has changed
+            return RtcVarBase::store(m_rtc, Mem, Offset, bytes(),
+                reinterpret_cast<const uint8_t*>(&value), SIZE);
+        }
+        RtcVar& operator=(const T& value) {store(value); return *this;}
+
+        // Forget the cached value, e.g. if something else has written
+        // the memory; the next access reads it from the RTC.
+        void invalidate() {m_valid = false;}
+
+    private:
+        MCP79412RTC& m_rtc;
+        T m_value {};
+        bool m_valid {false};
+
+        uint8_t* bytes() {return reinterpret_cast<uint8_t*>(&m_value);}
+};
+
+template <typename T, uint8_t Offset>
+using RtcSramVar = RtcVar<T, Offset, RtcVarBase::MEM_SRAM, MCP79412RTC::SRAM_SIZE>;
+
+template <typename T, uint8_t Offset>
+using RtcEepromVar = RtcVar<T, Offset, RtcVarBase::MEM_EEPROM, MCP79412RTC::EEPROM_SIZE>;
+
+// RtcLayout<Vars...>::valid is true if no two of the variables overlap.
+// Variables in different memories never overlap.
+template <typename A, typename B>
+struct RtcDisjoint
+{
+    static constexpr bool value {A::MEMORY != B::MEMORY
+        || A::END <= B::OFFSET || B::END <= A::OFFSET};
+};
+
+template <typename V, typename... Others>
+struct RtcDisjointAll               // V does not overlap any of Others
+{
+    static constexpr bool value {true};
+};
+
+template <typename V, typename O, typename... Others>
+struct RtcDisjointAll<V, O, Others...>
+{
+    static constexpr bool value {RtcDisjoint<V, O>::value
+        && RtcDisjointAll<V, Others...>::value};
+};
+
+template <typename... Vars>
+struct RtcLayout
+{
+    static constexpr bool valid {true};
+};
+
+template <typename V, typename... Rest>
+struct RtcLayout<V, Rest...>
+{
+    static constexpr bool valid {RtcDisjointAll<V, Rest...>::value
+        && RtcLayout<Rest...>::valid};
+};
+#endif
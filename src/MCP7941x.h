@@ -0,0 +1,1381 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// The MCP7941x driver, as a template on its I2C transport.
+// MCP7941x<Transport> has all of the functions of MCP79412RTC, but
+// talks to the RTC through the given transport (see
+// MCP7941xTransport.h) and has no virtual functions, so the compiler
+// can call, and inline, everything directly. MCP79412RTC is the
+// MCP7941x for the default transport (Wire, or TinyWireM on ATtiny)
+// plus the GenericRTC interface; use MCP7941x directly for another
+// transport, e.g. MCP7941x<LinuxI2CTransport>, or to do without the
+// virtual functions. The constants, enumerations and SNAPSHOT_t are in
+// the non-template MCP7941xBase, so MCP79412RTC::ALARM_0 and
+// MCP7941x<T>::ALARM_0 are the same thing.
+
+#ifndef MCP7941X_H_INCLUDED
+#define MCP7941X_H_INCLUDED
+
+#include <Arduino.h>
+#include <TimeLib.h>    // https://github.com/PaulStoffregen/Time
+#include <MCP7941xTransport.h>
+#include <MCP7941xCivil.h>
+#include <MCP79412BusLock.h>
+#include <MCP79412Stats.h>
+
+#ifndef _BV
+#define _BV(bit) (1 << (bit))
+#endif
+
+// for interrupt handlers, which some cores need in RAM
+#if defined(ARDUINO_ISR_ATTR)
+#define MCP79412_ISR_ATTR ARDUINO_ISR_ATTR
+#elif defined(IRAM_ATTR)
+#define MCP79412_ISR_ATTR IRAM_ATTR
+#else
+#define MCP79412_ISR_ATTR
+#endif
+
+class MCP7941xBase
+{
+    public:
+        // Alarm types for use with the enableAlarm() function
+        enum ALARM_TYPES_t {
+            ALM_MATCH_SECONDS,
+            ALM_MATCH_MINUTES,
+            ALM_MATCH_HOURS,
+            ALM_MATCH_DAY,      // triggers alarm at midnight
+            ALM_MATCH_DATE,
+            ALM_RESERVED_5,     // do not use
+            ALM_RESERVED_6,     // do not use
+            ALM_MATCH_DATETIME,
+            ALM_DISABLE
+        };
+
+        // Square-wave output frequencies for use with squareWave() function
+        enum SQWAVE_FREQS_t {
+            SQWAVE_1_HZ,
+            SQWAVE_4096_HZ,
+            SQWAVE_8192_HZ,
+            SQWAVE_32768_HZ,
+            SQWAVE_NONE
+        };
+
+        // constants for use with alarm functions
+        enum ALARM_NBR_t {
+            ALARM_0,
+            ALARM_1
+        };
+
+        // MCP7941x I2C Addresses
+        static constexpr uint8_t
+            RTC_ADDR    {0x6F},
+            EEPROM_ADDR {0x57};
+
+        // MCP7941x Register Addresses
+        static constexpr uint8_t
+            RTCSEC          {0x00}, // 7 registers, Seconds, Minutes, Hours, DOW, Date, Month, Year
+            RTCWKDAY        {0x03}, // the RTC Day register contains the OSCRUN, PWRFAIL, and VBATEN bits
+            RTCDATE         {0x04}, // RTC date register
+            RTCMTH          {0x05}, // RTC month register, with the LPYR bit
+            RTCYEAR         {0x06}, // RTC year register
+            CONTROL         {0x07}, // control register
+            OSCTRIM         {0x08}, // oscillator calibration register
+            EEUNLOCK        {0x09}, // protected eeprom unlock register
+            ALM0SEC         {0x0A}, // alarm 0, 6 registers, Seconds, Minutes, Hours, DOW, Date, Month
+            ALM1SEC         {0x11}, // alarm 1, 6 registers, Seconds, Minutes, Hours, DOW, Date, Month
+            ALM0WKDAY       {0x0D}, // DOW register has alarm config/flag bits
+            ALM1WKDAY       {0x14}, // alarm 1 DOW register
+            PWRDNMIN        {0x18}, // power-down timestamp, 4 registers, Minutes, Hours, Date, Month
+            PWRUPMIN        {0x1C}, // power-up timestamp, 4 registers, Minutes, Hours, Date, Month
+            TIMESTAMP_SIZE  {8},    // number of bytes in the two timestamp registers
+            SRAM_START_ADDR {0x20}, // first SRAM address
+            SRAM_SIZE       {64},   // number of bytes of SRAM
+            EEPROM_SIZE     {128},  // number of bytes of EEPROM
+            EEPROM_PAGE_SIZE{8},    // number of bytes on an EEPROM page
+            EEPROM_TIMEOUT_MS{10},  // max wait for an EEPROM write cycle (datasheet max is 5ms)
+            UNIQUE_ID_ADDR  {0xF0}, // starting address for unique ID in EEPROM
+            UNIQUE_ID_SIZE  {8},    // number of bytes in unique ID
+            I2C_BUFFER_SIZE {MCP79412_I2C_BUFFER > 255 ? 255 : MCP79412_I2C_BUFFER};    // default for setI2CBufferSize()
+
+        // Status codes. The I2C statuses are those of the Wire library,
+        // which every transport returns (see MCP7941xTransport.h).
+        static constexpr uint8_t
+            I2C_NACK_ADDR   {2},    // address not acknowledged, e.g. the EEPROM is busy with a write cycle
+            INVALID_ARGS    {0xFF}; // invalid arguments, nothing was transferred
+
+        // Control Register bits
+        static constexpr uint8_t
+            OUT     {7},    // sets logic level on MFP when not used as square wave output
+            SQWEN   {6},    // set to enable square wave output
+            ALM1EN  {5},    // alarm 1 is active
+            ALM0EN  {4},    // alarm 0 is active
+            EXTOSC  {3},    // enable external oscillator instead of a crystal
+            CRSTRIM {2},    // coarse trim mode enable
+            SQWFS1  {1},    // SQWFS1:0 square wave output freq: 0==1Hz, 1==4096Hz, 2==8192Hz, 3=32768Hz
+            SQWFS0  {0};
+
+        // Other Control Bits
+        static constexpr uint8_t
+            STOSC   {7},    // Seconds register (RTCSEC) oscillator start/stop bit, 1==Start, 0==Stop
+            HR1224  {6},    // Hours register (RTCHOUR) 12 or 24 hour mode (24 hour mode==0)
+            AMPM    {5},    // Hours register (RTCHOUR) AM/PM bit for 12 hour mode
+            OSCRUN  {5},    // Day register (RTCWKDAY) oscillator running (set and cleared by hardware)
+            PWRFAIL {4},    // Day register (RTCWKDAY) set by hardware when Vcc fails and RTC runs on battery.
+                            // PWRFAIL is cleared by software, clearing PWRFAIL also
+                            // clears the timestamp registers
+            VBATEN  {3},    // Day register (RTCWKDAY) VBATEN==1 enables backup
+                            // battery, VBATEN==0 disconnects the VBAT pin (e.g. to save battery)
+            LPYR    {5};    // Month register (RTCMTH) leap year bit
+
+        // Alarm Control Bits
+        static constexpr uint8_t
+            ALMPOL      {7},    // Alarm Polarity: Defines the logic level for the MFP when an alarm is triggered.
+            ALMxMSK2    {6},    // Alarm configuration bits determine how alarms match. See ALARM_TYPES_t enum.
+            ALMxMSK1    {5},
+            ALMxMSK0    {4},
+            ALMxIF      {3};    // Alarm Interrupt Flag: Set by hardware when an alarm was triggered, cleared by software.
+
+        // RTC status from a single burst read of registers RTCSEC through
+        // ALM1WKDAY, see snapshot()
+        struct SNAPSHOT_t {
+            tmElements_t tm;        // current date and time
+            time_t t;               // current date and time as a time_t
+            bool stOsc;             // oscillator enabled (STOSC)
+            bool oscRunning;        // oscillator running (OSCRUN)
+            bool powerFail;         // power failure recorded (PWRFAIL)
+            bool vbatEn;            // backup battery enabled (VBATEN)
+            bool alarm0;            // alarm 0 triggered (ALM0IF)
+            bool alarm1;            // alarm 1 triggered (ALM1IF)
+            int16_t calib;          // calibration value, as from calibRead()
+            uint8_t control;        // CONTROL register
+            uint8_t regs[ALM1WKDAY - RTCSEC + 1];   // raw register values
+        };
+};
+
+template <class Transport>
+class MCP7941x : public MCP7941xBase
+{
+    public:
+        MCP7941x(const Transport& transport=Transport()) : bus(transport) {}
+        void begin();
+        time_t get();
+        uint8_t set(const time_t t);
+        bool setPrecise(time_t t, uint32_t subsecondMicros=0);
+        uint16_t calibratePreciseLatency();
+        uint16_t getPreciseLatency() {return preciseLatency;}
+        void setPreciseLatency(const uint16_t us) {preciseLatency = us;}
+        bool read(tmElements_t& tm);
+        bool snapshot(SNAPSHOT_t& snap);
+        uint8_t clearAlarmFlags(SNAPSHOT_t& snap, const bool alarm0=true, const bool alarm1=true);
+        uint8_t write(const tmElements_t& tm);
+        void sramWrite(const uint8_t addr, const uint8_t value);
+        void sramWrite(const uint8_t addr, const uint8_t* values, const uint8_t nBytes);
+        uint8_t sramRead(const uint8_t addr);
+        void sramRead(const uint8_t addr, uint8_t* values, const uint8_t nBytes);
+        void eepromWrite(const uint8_t addr, const uint8_t value);
+        void eepromWrite(const uint8_t addr, const uint8_t* values, const uint8_t nBytes);
+        uint8_t eepromRead(const uint8_t addr);
+        void eepromRead(const uint8_t addr, uint8_t* values, const uint8_t nBytes);
+        uint8_t eepromWriteBulk(const uint8_t addr, const uint8_t* values, const uint8_t nBytes);
+        uint8_t eepromReadBulk(const uint8_t addr, uint8_t* values, const uint8_t nBytes);
+        uint8_t eepromWritePage(const uint8_t addr, const uint8_t* values, const uint8_t nBytes);
+        bool eepromReady();
+        int16_t calibRead();
+        void calibWrite(const int16_t value);
+        void coarseTrim(const bool enable);
+        bool isCoarseTrim() {return readConfig(CONTROL) & _BV(CRSTRIM);}
+        void idRead(uint8_t* uniqueID);
+        void getEUI64(uint8_t* uniqueID);
+        bool powerFail(time_t* powerDown, time_t* powerUp, uint16_t* anchor=nullptr);
+        void squareWave(const SQWAVE_FREQS_t freq);
+        void setAlarm(const ALARM_NBR_t alarmNumber, const time_t alarmTime);
+        void setAlarm(const ALARM_NBR_t alarmNumber, const uint16_t y, const uint8_t mon,
+                      const uint8_t d, const uint8_t h, const uint8_t m, const uint8_t s);
+        void enableAlarm(const ALARM_NBR_t alarmNumber, const ALARM_TYPES_t alarmType);
+        bool alarm(const ALARM_NBR_t alarmNumber);
+        void out(const bool level);
+        void alarmPolarity(const bool polarity);
+        bool isRunning();
+        void vbaten(const bool enable);
+        void shadowRegisters(const bool enable);
+        void setI2CBufferSize(const uint8_t size);
+        uint8_t i2cBufferSize() {return i2cBufSize;}
+        void setBusLock(MCP79412BusLock* lock) {busLock = lock;}
+        MCP79412BusLock* getBusLock() {return busLock;}
+        void dumpRegs(const uint32_t startAddr=0, const uint32_t nBytes=32);
+        void dumpSRAM(const uint32_t startAddr=0, const uint32_t nBytes=64);
+        void dumpEEPROM(const uint32_t startAddr=0, const uint32_t nBytes=128);
+
+        uint8_t writeRTC(const uint8_t addr, const uint8_t* values, const uint8_t nBytes);
+        uint8_t writeRTC(const uint8_t addr, const uint8_t value);
+        uint8_t readRTC(const uint8_t addr, uint8_t* values, const uint8_t nBytes);
+        uint8_t readRTC(const uint8_t addr);
+        Transport& transport() {return bus;}
+#ifdef MCP79412_STATS
+        MCP79412Stats& stats() {return bus.stats();}
+#endif
+
+    protected:
+        // for the classes that program the alarms themselves
+        friend class MCP79412AlarmService;
+        friend class MCP79412DutyPlanner;
+        friend class MCP79412Scheduler;
+        uint8_t setAlarmEnable(const ALARM_NBR_t alarmNumber, const bool enable);
+        uint8_t alarmPolarityBit(const ALARM_NBR_t alarmNumber);
+        static uint8_t alarmPolarityBit(const ALARM_NBR_t alarmNumber, const uint8_t day)
+            {return alarmNumber == ALARM_0 ? day & _BV(ALMPOL) : 0;}
+        static uint8_t alarmRegister(const ALARM_NBR_t alarmNumber, const uint8_t alm0Addr)
+            {return alm0Addr + alarmNumber * (ALM1SEC - ALM0SEC);}
+
+    private:
+#ifdef MCP79412_STATS
+        MCP79412CountingTransport<Transport> bus;   // the I2C transport, counting transfers
+#else
+        Transport bus;              // the I2C transport
+#endif
+        uint8_t i2cBufSize {Transport::BUFFER_SIZE};   // largest transfer, see setI2CBufferSize()
+        MCP79412BusLock* busLock {nullptr};     // held by each function, see setBusLock()
+        uint32_t getSeq {0};                    // reads begun by get(), read and written in the lock's critical section
+        uint32_t getSeqCached {0};              // sequence number of the last read by get()
+        time_t getCached {0};                   // and the time it read
+        uint16_t preciseLatency {0};            // microseconds to write the seconds, see setPrecise()
+        bool shadowOn {false};      // shadow the configuration registers
+        bool shadowValid {false};   // shadow copies have been loaded
+        uint8_t shadowCtrl;         // shadow copy of CONTROL
+        uint8_t shadowAlmDay[2];    // shadow copies of ALM0WKDAY, ALM1WKDAY, less ALMxIF
+        uint8_t* shadowReg(const uint8_t addr);
+        bool shadowLoad();
+        void shadowUpdate(const uint8_t addr, const uint8_t* values, const uint8_t nBytes);
+        uint8_t readConfig(const uint8_t addr);
+        uint8_t eepromWait();
+        void decodeTime(const uint8_t* regs, tmElements_t& tm);
+        uint8_t writeTime(const uint8_t* regs);
+        static time_t stampBefore(const uint8_t* ts, const time_t limit);
+        static void waitUntil(const uint32_t start, const uint32_t offset);
+        static constexpr uint16_t
+            eeWaitMicros {MCP7941xEepromWait<Transport>::value},    // see MCP7941xTransport.h
+            eePollMicros {MCP7941xEepromPoll<Transport>::value};
+        static uint8_t dec2bcd(const uint8_t n) {return MCP7941xCivil::dec2bcd(n);}
+        static uint8_t bcd2dec(const uint8_t n) {return MCP7941xCivil::bcd2dec(n);}
+};
+
+// Initialize the I2C bus. If the register shadow is enabled (see
+// shadowRegisters()), load it from the RTC.
+template <class Transport>
+void MCP7941x<Transport>::begin()
+{
+    MCP79412BusGuard guard(busLock);
+    bus.begin();
+    if (shadowOn) shadowLoad();
+}
+
+// Read the current time from the RTC and return it as a time_t value.
+// Returns a zero value if RTC not present (I2C I/O error).
+// With a bus lock (see setBusLock()), callers that arrive while another
+// task holds the lock share a read: a caller that gets the lock after
+// a read that began after the caller arrived returns that read's time
+// instead of reading the RTC again. So tasks calling get() at the same
+// time share reads, and each still gets a time read after its call
+// began. The read sequence number is read before taking the lock, so
+// it is read and written in the lock's critical section.
+template <class Transport>
+time_t MCP7941x<Transport>::get()
+{
+    uint32_t arrival {0};           // reads begun before this call
+    if (busLock) {
+        busLock->enterCritical();
+        arrival = getSeq;
+        busLock->exitCritical();
+    }
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_GET);
+    if (busLock && getSeqCached > arrival) return getCached;
+
+    uint32_t seq {getSeq + 1};
+    if (busLock) busLock->enterCritical();
+    getSeq = seq;
+    if (busLock) busLock->exitCritical();
+    uint8_t regs[tmNbrFields];
+    time_t t = readRTC(RTCSEC, regs, tmNbrFields) == 0 ? MCP7941xCivil::regsToTime(regs) : 0;
+    getCached = t;
+    getSeqCached = seq;
+    return t;
+}
+
+// Set the RTC to the given time_t value.
+// Returns the I2C status (zero if successful).
+template <class Transport>
+uint8_t MCP7941x<Transport>::set(const time_t t)
+{
+    MCP79412_STATS_SCOPE(OP_SET);
+    uint8_t regs[tmNbrFields];
+    MCP7941xCivil::timeToRegs(t, regs);
+    return writeTime(regs);
+}
+
+// Set the RTC to the given time so that its seconds tick in step with
+// the caller's. The caller's time when this function is called is t
+// plus subsecondMicros, so the RTC is set to t+1 at the next second
+// boundary, or to t+2 at the one after that if there is not time
+// enough. The time and date registers are written, with the
+// oscillator stopped, just before the boundary, then the seconds are
+// written, with the oscillator started, so that the write completes
+// on the boundary: it is started early by the time such a write
+// takes, measured by calibratePreciseLatency() the first time and by
+// each call after that (so calibrate again after changing the I2C
+// clock). The bus is held for up to two seconds.
+// Returns true if a snapshot() read afterwards has the time set, the
+// oscillator enabled and battery backup enabled.
+template <class Transport>
+bool MCP7941x<Transport>::setPrecise(time_t t, uint32_t subsecondMicros)
+{
+    uint32_t start = micros();
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_SET);
+    t += subsecondMicros / 1000000;
+    subsecondMicros %= 1000000;
+    if (preciseLatency == 0 && calibratePreciseLatency() == 0) return false;
+
+    // write the time and date ahead of the boundary by about four times
+    // the latency, which is about what the write takes, and try again
+    // for the next boundary if the write was too late
+    time_t target {t + 1};
+    uint32_t boundary {1000000 - subsecondMicros};  // microseconds after start
+    uint32_t due;                                   // when to write the seconds
+    uint8_t regs[tmNbrFields];
+    while (true) {
+        due = boundary - preciseLatency;
+        if (boundary > 5UL * preciseLatency && micros() - start <= due - 4UL * preciseLatency) {
+            waitUntil(start, due - 4UL * preciseLatency);
+            MCP7941xCivil::timeToRegs(target, regs);
+            uint8_t seconds {regs[0]};
+            regs[0] = 0x00;                         // stops the oscillator (Bit 7, STOSC == 0)
+            regs[3] |= _BV(VBATEN);                 // enable battery backup operation
+            if (writeRTC(RTCSEC, regs, tmNbrFields) != 0) return false;
+            regs[0] = seconds;
+            if (micros() - start <= due) break;
+        }
+        ++target;
+        boundary += 1000000;
+    }
+
+    waitUntil(start, due);
+    uint32_t begun = micros();
+    if (writeRTC(RTCSEC, regs[0] | _BV(STOSC)) != 0) return false;
+    uint32_t took = micros() - begun;
+    preciseLatency = took < 0xFFFF ? took : 0xFFFF;
+
+    SNAPSHOT_t snap;
+    return snapshot(snap) && snap.t == target && snap.stOsc && snap.vbatEn;
+}
+
+// Measure the time that a write of one RTC register takes, as
+// setPrecise() writes the seconds, by writing OSCTRIM with the value
+// it has. Returns the time in microseconds, which setPrecise() then
+// uses, or zero if there was an I2C error.
+template <class Transport>
+uint16_t MCP7941x<Transport>::calibratePreciseLatency()
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_SET);
+    uint8_t trim;
+    if (readRTC(OSCTRIM, &trim, 1) != 0) return 0;
+    uint32_t begun = micros();
+    if (writeRTC(OSCTRIM, trim) != 0) return 0;
+    uint32_t took = micros() - begun;
+    preciseLatency = took == 0 ? 1 : took < 0xFFFF ? took : 0xFFFF;
+    return preciseLatency;
+}
+
+// Wait until the given number of microseconds after start, with
+// delay() for all but the last two milliseconds or so.
+template <class Transport>
+void MCP7941x<Transport>::waitUntil(const uint32_t start, const uint32_t offset)
+{
+    uint32_t elapsed;
+    while ((elapsed = micros() - start) < offset) {
+        uint32_t rest {offset - elapsed};
+        if (rest > 2000) delay(rest / 1000 - 1);
+        else delayMicroseconds(rest);
+    }
+}
+
+// Read the current time from the RTC and return it in a tmElements_t
+// structure. Returns false if RTC not present (I2C I/O error).
+template <class Transport>
+bool MCP7941x<Transport>::read(tmElements_t& tm)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_READ);
+    // read 7 bytes (secs, min, hr, dow, date, mth, yr)
+    uint8_t regs[tmNbrFields];
+    if (readRTC(RTCSEC, regs, tmNbrFields) != 0) {
+        return false;
+    }
+    else {
+        decodeTime(regs, tm);
+        return true;
+    }
+}
+
+// Read the time, the status bits, the calibration and control registers
+// and both alarms' configuration and flags with a single burst read of
+// registers RTCSEC through ALM1WKDAY, and decode them into a SNAPSHOT_t
+// structure. This replaces separate calls to get(), isRunning(),
+// powerFail() (for the status only), calibRead() and alarm().
+// Unlike alarm(), the alarm flags are not cleared, see clearAlarmFlags().
+// Returns false if RTC not present (I2C I/O error).
+template <class Transport>
+bool MCP7941x<Transport>::snapshot(SNAPSHOT_t& snap)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_READ);
+    uint8_t* r = snap.regs;
+    if (readRTC(RTCSEC, r, sizeof(snap.regs)) != 0) return false;
+
+    decodeTime(r, snap.tm);
+    snap.t = MCP7941xCivil::regsToTime(r);
+    snap.stOsc = r[RTCSEC] & _BV(STOSC);
+    snap.oscRunning = r[RTCWKDAY] & _BV(OSCRUN);
+    snap.powerFail = r[RTCWKDAY] & _BV(PWRFAIL);
+    snap.vbatEn = r[RTCWKDAY] & _BV(VBATEN);
+    snap.alarm0 = r[ALM0WKDAY] & _BV(ALMxIF);
+    snap.alarm1 = r[ALM1WKDAY] & _BV(ALMxIF);
+    snap.calib = (r[OSCTRIM] & 0x80) ? -(r[OSCTRIM] & 0x7F) : r[OSCTRIM];
+    snap.control = r[CONTROL];
+    return true;
+}
+
+// Clear the alarm flags reported by a snapshot, with a single write.
+// Clearing one flag writes its ALMxWKDAY register. Clearing both writes
+// registers ALM0WKDAY through ALM1WKDAY in one transfer, using the
+// snapshot's values for the alarm registers in between, so no other
+// alarm settings should be changed between the snapshot and this call.
+// Flags that are not being cleared are written as ones, which leaves
+// them as they are. The snapshot is updated to match.
+// Returns the I2C status (zero if successful).
+template <class Transport>
+uint8_t MCP7941x<Transport>::clearAlarmFlags(SNAPSHOT_t& snap, const bool alarm0, const bool alarm1)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_ALARM);
+    uint8_t* r = snap.regs;
+    r[ALM0WKDAY] = alarm0 ? r[ALM0WKDAY] & ~_BV(ALMxIF) : r[ALM0WKDAY] | _BV(ALMxIF);
+    r[ALM1WKDAY] = alarm1 ? r[ALM1WKDAY] & ~_BV(ALMxIF) : r[ALM1WKDAY] | _BV(ALMxIF);
+
+    uint8_t e {0};
+    if (alarm0 && alarm1) e = writeRTC(ALM0WKDAY, r + ALM0WKDAY, ALM1WKDAY - ALM0WKDAY + 1);
+    else if (alarm0) e = writeRTC(ALM0WKDAY, r[ALM0WKDAY]);
+    else if (alarm1) e = writeRTC(ALM1WKDAY, r[ALM1WKDAY]);
+
+    if (e == 0) {
+        if (alarm0) snap.alarm0 = false;
+        if (alarm1) snap.alarm1 = false;
+    }
+    r[ALM0WKDAY] = snap.alarm0 ? r[ALM0WKDAY] | _BV(ALMxIF) : r[ALM0WKDAY] & ~_BV(ALMxIF);
+    r[ALM1WKDAY] = snap.alarm1 ? r[ALM1WKDAY] | _BV(ALMxIF) : r[ALM1WKDAY] & ~_BV(ALMxIF);
+    return e;
+}
+
+// Decode the seven time and date registers, starting with RTCSEC.
+template <class Transport>
+void MCP7941x<Transport>::decodeTime(const uint8_t* regs, tmElements_t& tm)
+{
+    tm.Second = bcd2dec(regs[0] & ~_BV(STOSC));
+    tm.Minute = bcd2dec(regs[1]);
+    tm.Hour = bcd2dec(regs[2] & ~_BV(HR1224));      // assumes 24hr clock
+    tm.Wday = regs[3] & ~(_BV(OSCRUN) | _BV(PWRFAIL) | _BV(VBATEN));    // mask off OSCRUN, PWRFAIL, VBATEN bits
+    tm.Day = bcd2dec(regs[4]);
+    tm.Month = bcd2dec(regs[5] & ~_BV(LPYR));       // mask off the leap year bit
+    tm.Year = y2kYearToTm(bcd2dec(regs[6]));
+}
+
+// Set the RTC's time from a tmElements_t structure.
+template <class Transport>
+uint8_t MCP7941x<Transport>::write(const tmElements_t& tm)
+{
+    MCP79412_STATS_SCOPE(OP_SET);
+    uint8_t regs[tmNbrFields] {
+        dec2bcd(tm.Second),
+        dec2bcd(tm.Minute),
+        dec2bcd(tm.Hour),
+        tm.Wday,
+        dec2bcd(tm.Day),
+        dec2bcd(tm.Month),
+        dec2bcd(tmYearToY2k(tm.Year))
+    };
+    return writeTime(regs);
+}
+
+// Set the RTC's time from the seven time and date registers, RTCSEC
+// through RTCYEAR, in BCD. The oscillator is stopped while the
+// registers are written, then the seconds are written and the
+// oscillator started.
+template <class Transport>
+uint8_t MCP7941x<Transport>::writeTime(const uint8_t* regs)
+{
+    MCP79412BusGuard guard(busLock);
+    bus.beginTransmission(RTC_ADDR);
+    bus.write(RTCSEC);
+    bus.write(0x00);                            // stops the oscillator (Bit 7, STOSC == 0)
+    bus.write(regs[1]);
+    bus.write(regs[2]);                         // sets 24 hour format (Bit 6 == 0)
+    bus.write(regs[3] | _BV(VBATEN));           // enable battery backup operation
+    bus.write(regs[4]);
+    bus.write(regs[5]);
+    bus.write(regs[6]);
+    bus.endTransmission();
+
+    bus.beginTransmission(RTC_ADDR);
+    bus.write(RTCSEC);
+    bus.write(regs[0] | _BV(STOSC));            // set the seconds and start the oscillator (Bit 7, STOSC == 1)
+    uint8_t ret = bus.endTransmission();
+    return ret;
+}
+
+// Write a single byte to RTC RAM.
+// Valid address range is 0x00 - 0x5F, no checking.
+template <class Transport>
+uint8_t MCP7941x<Transport>::writeRTC(const uint8_t addr, const uint8_t value)
+{
+    MCP79412_STATS_SCOPE(OP_REGISTER);
+    return ( writeRTC(addr, &value, 1) );
+}
+
+// Write multiple bytes to RTC RAM.
+// Valid address range is 0x00 - 0x5F, no checking.
+// Writes longer than the I2C buffer allows (see setI2CBufferSize())
+// are split into as few transfers as possible.
+template <class Transport>
+uint8_t MCP7941x<Transport>::writeRTC(const uint8_t addr, const uint8_t* values, const uint8_t nBytes)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_REGISTER);
+    const uint8_t maxChunk = i2cBufSize - 1;    // less the register address
+    uint8_t done {0};
+    do {
+        uint8_t len = nBytes - done;
+        if (len > maxChunk) len = maxChunk;
+        bus.beginTransmission(RTC_ADDR);
+        bus.write(addr + done);
+        for (uint8_t i=0; i<len; i++) bus.write(values[done + i]);
+        if ( uint8_t e = bus.endTransmission() ) return e;
+        shadowUpdate(addr + done, values + done, len);
+        done += len;
+    } while (done < nBytes);
+    return 0;
+}
+
+// Read a single byte from RTC RAM.
+// Valid address range is 0x00 - 0x5F, no checking.
+template <class Transport>
+uint8_t MCP7941x<Transport>::readRTC(uint8_t addr)
+{
+    MCP79412_STATS_SCOPE(OP_REGISTER);
+    uint8_t value;
+
+    readRTC(addr, &value, 1);
+    return value;
+}
+
+// Read multiple bytes from RTC RAM.
+// Valid address range is 0x00 - 0x5F, no checking.
+// The register address is sent once, then reads longer than the I2C
+// buffer allows (see setI2CBufferSize()) are split into as few
+// transfers as possible; the RTC's address pointer advances from one
+// transfer to the next. The first read follows the register address
+// with a repeated START, without releasing the bus.
+template <class Transport>
+uint8_t MCP7941x<Transport>::readRTC(const uint8_t addr, uint8_t* values, const uint8_t nBytes)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_REGISTER);
+    bus.beginTransmission(RTC_ADDR);
+    bus.write(addr);
+    if ( uint8_t e = bus.endTransmission(false) ) return e;
+    uint8_t done {0};
+    while (done < nBytes) {
+        uint8_t len = nBytes - done;
+        if (len > i2cBufSize) len = i2cBufSize;
+        bus.requestFrom(RTC_ADDR, len);
+        for (uint8_t i=0; i<len; i++) values[done + i] = bus.read();
+        done += len;
+    }
+    shadowUpdate(addr, values, nBytes);
+    return 0;
+}
+
+// Write a single byte to Static RAM.
+// Address (addr) is constrained to the range (0, 63).
+template <class Transport>
+void MCP7941x<Transport>::sramWrite(const uint8_t addr, const uint8_t value)
+{
+    MCP79412_STATS_SCOPE(OP_SRAM_WRITE);
+    writeRTC( (addr & (SRAM_SIZE - 1) ) + SRAM_START_ADDR, &value, 1 );
+}
+
+// Write multiple bytes to Static RAM.
+// Address (addr) is constrained to the range (0, 63).
+// Number of bytes (nBytes) must be between 1 and 64; writes longer
+// than the I2C buffer allows are split into as few transfers as
+// possible.
+// Invalid values for nBytes, or combinations of addr and nBytes
+// that would result in addressing past the last byte of SRAM will
+// result in no action.
+template <class Transport>
+void MCP7941x<Transport>::sramWrite(const uint8_t addr, const uint8_t* values, const uint8_t nBytes)
+{
+    MCP79412_STATS_SCOPE(OP_SRAM_WRITE);
+    if (nBytes >= 1 && (addr + nBytes) <= SRAM_SIZE) {
+        writeRTC( (addr & (SRAM_SIZE - 1) ) + SRAM_START_ADDR, values, nBytes );
+    }
+}
+
+// Read a single byte from Static RAM.
+// Address (addr) is constrained to the range (0, 63).
+template <class Transport>
+uint8_t MCP7941x<Transport>::sramRead(const uint8_t addr)
+{
+    MCP79412_STATS_SCOPE(OP_SRAM_READ);
+    uint8_t value;
+
+    readRTC( (addr & (SRAM_SIZE - 1) ) + SRAM_START_ADDR, &value, 1 );
+    return value;
+}
+
+// Read multiple bytes from Static RAM.
+// Address (addr) is constrained to the range (0, 63).
+// Number of bytes (nBytes) must be between 1 and 64; reads longer
+// than the I2C buffer allows are split into as few transfers as
+// possible.
+// Invalid values for nBytes, or combinations of addr and
+// nBytes that would result in addressing past the last byte of SRAM
+// result in no action.
+template <class Transport>
+void MCP7941x<Transport>::sramRead(const uint8_t addr, uint8_t* values, const uint8_t nBytes)
+{
+    MCP79412_STATS_SCOPE(OP_SRAM_READ);
+    if (nBytes >= 1 && (addr + nBytes) <= SRAM_SIZE) {
+        readRTC((addr & (SRAM_SIZE - 1) ) + SRAM_START_ADDR, values, nBytes);
+    }
+}
+
+// Write a single byte to EEPROM.
+// Address (addr) is constrained to the range (0, 127).
+// Can't leverage page write function because a write can't start
+// mid-page.
+template <class Transport>
+void MCP7941x<Transport>::eepromWrite(const uint8_t addr, const uint8_t value)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_EEPROM_WRITE);
+    if ( eepromWritePage(addr & (EEPROM_SIZE - 1), &value, 1) == 0 ) eepromWait();
+}
+
+// Write a page (or less) to EEPROM. An EEPROM page is 8 bytes.
+// Address (addr) should be a page start address (0, 8, ..., 120), but
+// is ruthlessly coerced into a valid value.
+// Number of bytes (nBytes) must be between 1 and 8, other values
+// result in no action.
+template <class Transport>
+void MCP7941x<Transport>::eepromWrite(const uint8_t addr, const uint8_t* values, const uint8_t nBytes)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_EEPROM_WRITE);
+    if (nBytes >= 1 && nBytes <= EEPROM_PAGE_SIZE) {
+        uint8_t a = addr & ~(EEPROM_PAGE_SIZE - 1) & (EEPROM_SIZE - 1);
+        if ( eepromWritePage(a, values, nBytes) == 0 ) eepromWait();
+    }
+}
+
+// Write any number of bytes to EEPROM, starting at any address.
+// The data is split at page boundaries, and each page is written as soon
+// as the EEPROM finishes the previous one: while a write cycle is in
+// progress the EEPROM does not acknowledge its address, so retrying the
+// page write doubles as the acknowledge poll and no separate polling
+// transactions are needed. With a transport that paces EEPROM polling
+// (see MCP7941xTransport.h), it sleeps through most of each write cycle
+// and then polls at the transport's interval instead. Returns after the
+// last write cycle completes.
+// addr + nBytes must not exceed EEPROM_SIZE, otherwise no action is
+// taken and INVALID_ARGS is returned.
+// Returns the I2C status (zero if successful). A status of
+// I2C_NACK_ADDR means the EEPROM did not respond within
+// EEPROM_TIMEOUT_MS.
+template <class Transport>
+uint8_t MCP7941x<Transport>::eepromWriteBulk(const uint8_t addr, const uint8_t* values, const uint8_t nBytes)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_EEPROM_WRITE);
+    if (nBytes < 1 || addr + nBytes > EEPROM_SIZE) return INVALID_ARGS;
+
+    uint8_t a {addr};
+    uint8_t n {nBytes};
+    while (n > 0) {
+        uint8_t len = EEPROM_PAGE_SIZE - (a & (EEPROM_PAGE_SIZE - 1));
+        if (len > n) len = n;
+        uint8_t e;
+        uint32_t msStart = millis();
+        e = eepromWritePage(a, values, len);
+        while (e == I2C_NACK_ADDR && millis() - msStart <= EEPROM_TIMEOUT_MS) {
+            MCP79412_STATS_COUNT(eepromRetry());
+            if (eePollMicros) delayMicroseconds(eePollMicros);
+            e = eepromWritePage(a, values, len);
+        }
+        if (e) return e;
+        values += len;
+        a += len;
+        n -= len;
+        if (n > 0 && eeWaitMicros) delayMicroseconds(eeWaitMicros);
+    }
+    return eepromWait() ? 0 : I2C_NACK_ADDR;
+}
+
+// Read any number of bytes from EEPROM, starting at any address.
+// The EEPROM's address pointer is set once, then the data is read in
+// transfers as large as the I2C buffer allows (see setI2CBufferSize());
+// the pointer advances from one transfer to the next. The first read
+// follows the address with a repeated START.
+// addr + nBytes must not exceed EEPROM_SIZE, otherwise no action is
+// taken and INVALID_ARGS is returned.
+// Returns the I2C status (zero if successful).
+template <class Transport>
+uint8_t MCP7941x<Transport>::eepromReadBulk(const uint8_t addr, uint8_t* values, const uint8_t nBytes)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_EEPROM_READ);
+    if (nBytes < 1 || addr + nBytes > EEPROM_SIZE) return INVALID_ARGS;
+
+    bus.beginTransmission(EEPROM_ADDR);
+    bus.write(addr);
+    if ( uint8_t e = bus.endTransmission(false) ) return e;
+    uint8_t n {nBytes};
+    while (n > 0) {
+        uint8_t len = (n > i2cBufSize) ? i2cBufSize : n;
+        bus.requestFrom(EEPROM_ADDR, len);
+        for (uint8_t i=0; i<len; i++) *values++ = bus.read();
+        n -= len;
+    }
+    return 0;
+}
+
+// Start an EEPROM write cycle and return without waiting for it to
+// complete. The bytes must all be on the same page, i.e. addr may be
+// anywhere on a page but addr + nBytes must not go past the end of the
+// page, otherwise no action is taken and the function returns
+// INVALID_ARGS. Use eepromReady() to find out when the write cycle is
+// complete.
+// Returns the I2C status (zero if successful). A status of
+// I2C_NACK_ADDR means the EEPROM is still busy with the previous write.
+template <class Transport>
+uint8_t MCP7941x<Transport>::eepromWritePage(const uint8_t addr, const uint8_t* values, const uint8_t nBytes)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_EEPROM_WRITE);
+    if ( nBytes < 1 || addr >= EEPROM_SIZE
+        || (addr & (EEPROM_PAGE_SIZE - 1)) + nBytes > EEPROM_PAGE_SIZE ) return INVALID_ARGS;
+    bus.beginTransmission(EEPROM_ADDR);
+    bus.write(addr);
+    for (uint8_t i=0; i<nBytes; i++) bus.write(values[i]);
+    return bus.endTransmission();
+}
+
+// Acknowledge polling: returns true if the EEPROM responds to its
+// address, i.e. it is not busy with a write cycle.
+template <class Transport>
+bool MCP7941x<Transport>::eepromReady()
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_EEPROM_WRITE);
+    bus.beginTransmission(EEPROM_ADDR);
+    bus.write(0);
+    return bus.endTransmission() == 0;
+}
+
+// Read a single byte from EEPROM.
+// Address (addr) is constrained to the range (0, 127).
+template <class Transport>
+uint8_t MCP7941x<Transport>::eepromRead(const uint8_t addr)
+{
+    MCP79412_STATS_SCOPE(OP_EEPROM_READ);
+    uint8_t value;
+
+    eepromRead( addr & (EEPROM_SIZE - 1), &value, 1 );
+    return value;
+}
+
+// Read multiple bytes from EEPROM.
+// Address (addr) is constrained to the range (0, 127).
+// Number of bytes (nBytes) must be between 1 and 128.
+// Invalid values for addr or nBytes, or combinations of addr and
+// nBytes that would result in addressing past the last byte of EEPROM
+// result in no action.
+template <class Transport>
+void MCP7941x<Transport>::eepromRead(const uint8_t addr, uint8_t* values, const uint8_t nBytes)
+{
+    MCP79412_STATS_SCOPE(OP_EEPROM_READ);
+    eepromReadBulk(addr, values, nBytes);
+}
+
+// Wait for EEPROM write to complete, giving up after EEPROM_TIMEOUT_MS.
+// With a transport that paces EEPROM polling (see MCP7941xTransport.h),
+// sleep through most of the write cycle first and between polls.
+// Returns the number of times the EEPROM was polled, or zero if it
+// did not respond in time.
+template <class Transport>
+uint8_t MCP7941x<Transport>::eepromWait()
+{
+    uint8_t waitCount{0};
+    uint32_t msStart = millis();
+
+    if (eeWaitMicros) delayMicroseconds(eeWaitMicros);
+    do {
+        if (waitCount < 255) ++waitCount;
+        if ( eepromReady() ) {
+            MCP79412_STATS_COUNT(eepromPoll(waitCount));
+            return waitCount;
+        }
+        if (eePollMicros) delayMicroseconds(eePollMicros);
+    } while (millis() - msStart <= EEPROM_TIMEOUT_MS);
+
+    MCP79412_STATS_COUNT(eepromPoll(waitCount));
+    return 0;
+}
+
+// Read the calibration register.
+// The calibration value is not a twos-complement number. The MSB is
+// the sign bit, and the 7 LSBs are an unsigned number, so we convert
+// it and return it to the caller as a regular twos-complement integer.
+template <class Transport>
+int16_t MCP7941x<Transport>::calibRead()
+{
+    MCP79412_STATS_SCOPE(OP_CALIB);
+    uint8_t val {readRTC(OSCTRIM)};
+
+    if ( val & 0x80 ) return -(val & 0x7F);
+    else return val;
+}
+
+// Write the calibration register.
+// Calibration value must be between -127 and 127, others result
+// in no action. See note above on the format of the calibration value.
+template <class Transport>
+void MCP7941x<Transport>::calibWrite(const int16_t value)
+{
+    MCP79412_STATS_SCOPE(OP_CALIB);
+    if (value >= -127 && value <= 127) {
+        uint8_t calibVal = abs(value);
+        if (value < 0) calibVal += 128;
+        writeRTC(OSCTRIM, calibVal);
+    }
+}
+
+// Enable or disable coarse trim mode (the CRSTRIM bit). In coarse
+// mode, the calibration value is applied 128 times per second instead
+// of once per minute, i.e. each step is about 7800 ppm instead of 1.
+template <class Transport>
+void MCP7941x<Transport>::coarseTrim(const bool enable)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_CALIB);
+    uint8_t ctrlReg {readConfig(CONTROL)};
+    if (enable)
+        ctrlReg |= _BV(CRSTRIM);
+    else
+        ctrlReg &= ~_BV(CRSTRIM);
+    writeRTC(CONTROL, &ctrlReg, 1);
+}
+
+// Read the unique ID.
+// For the MCP79411 (EUI-48), the first two bytes will contain 0xFF.
+// Caller must provide an 8-byte array to contain the results.
+template <class Transport>
+void MCP7941x<Transport>::idRead(uint8_t* uniqueID)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_ID);
+    bus.beginTransmission(EEPROM_ADDR);
+    bus.write(UNIQUE_ID_ADDR);
+    bus.endTransmission(false);
+    bus.requestFrom( EEPROM_ADDR, UNIQUE_ID_SIZE );
+    for (uint8_t i=0; i<UNIQUE_ID_SIZE; i++) uniqueID[i] = bus.read();
+}
+
+// Returns an EUI-64 ID. For an MCP79411, the EUI-48 ID is converted to
+// EUI-64. For an MCP79412, calling this function is equivalent to
+// calling idRead(). For an MCP79412, if the RTC type is known, calling
+// idRead() will be a bit more efficient.
+// Caller must provide an 8-byte array to contain the results.
+template <class Transport>
+void MCP7941x<Transport>::getEUI64(uint8_t* uniqueID)
+{
+    MCP79412_STATS_SCOPE(OP_ID);
+    uint8_t rtcID[8];
+
+    idRead(rtcID);
+    if (rtcID[0] == 0xFF && rtcID[1] == 0xFF) {
+        rtcID[0] = rtcID[2];
+        rtcID[1] = rtcID[3];
+        rtcID[2] = rtcID[4];
+        rtcID[3] = 0xFF;
+        rtcID[4] = 0xFE;
+    }
+    for (uint8_t i=0; i<UNIQUE_ID_SIZE; i++) uniqueID[i] = rtcID[i];
+}
+
+// Check to see if a power failure has occurred. If so, returns TRUE
+// as the function value, and returns the power down and power up
+// timestamps. After returning the time stamps, the RTC's timestamp
+// registers are cleared and the PWRFAIL bit which indicates a power
+// failure is reset. The status, the date and the timestamps are read
+// with a single burst read of RTCWKDAY through PWRUPMTH.
+//
+// Note that the power down and power up timestamp registers do not
+// contain values for seconds or for the year. The power up year is the
+// latest that puts the power up no later than today, so an outage read
+// in the year after the power up is right. The power down year is the
+// latest that puts the power down before the power up, unless an
+// anchor is given: the day (days since 1 Jan 1970) of a previous call,
+// which the caller keeps, e.g. in SRAM (0 if unknown). The power down
+// is then the earliest time after the anchor day, which is exact for
+// an outage of any length that began within a year of the previous
+// call. The anchor is updated to today, whether or not there was a
+// power failure.
+//
+// Finally, note that once the RTC records a power outage, it must be
+// cleared before another will be recorded.
+template <class Transport>
+bool MCP7941x<Transport>::powerFail(time_t* powerDown, time_t* powerUp, uint16_t* anchor)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_POWER_FAIL);
+    uint8_t r[PWRDNMIN + TIMESTAMP_SIZE - RTCWKDAY];
+    if (readRTC(RTCWKDAY, r, sizeof(r)) != 0) return false;
+    uint16_t today = MCP7941xCivil::daysFromCivil(2000 + bcd2dec(r[RTCYEAR - RTCWKDAY]),
+        bcd2dec(r[RTCMTH - RTCWKDAY] & 0x1F), bcd2dec(r[RTCDATE - RTCWKDAY]));
+    uint16_t since = (anchor && *anchor <= today) ? *anchor : 0;
+    if (anchor) *anchor = today;
+    if ( !(r[0] & _BV(PWRFAIL)) ) return false;
+
+    const uint8_t* dn = r + PWRDNMIN - RTCWKDAY;
+    *powerUp = stampBefore(r + PWRUPMIN - RTCWKDAY, (today + 1UL) * MCP7941xCivil::DAY_SECONDS - 1);
+    *powerDown = stampBefore(dn, *powerUp);
+    if (since) {
+        time_t t;
+        while (*powerDown && (t = stampBefore(dn, *powerDown - 1)) >= since * MCP7941xCivil::DAY_SECONDS) {
+            *powerDown = t;
+        }
+    }
+
+    // clear the PWRFAIL bit, which causes the RTC hardware to clear the
+    // timestamps too. If the day of the week changed since the read, it
+    // is set back, but makeTime() and get() do not use it.
+    r[0] &= ~_BV(PWRFAIL);
+    writeRTC(RTCWKDAY, r[0]);
+    return true;
+}
+
+// The time of a power down or power up timestamp (minutes, hours,
+// date, month) in the latest year that puts it no later than the given
+// time, or zero if there is none in the eight years (two leap years)
+// before it.
+template <class Transport>
+time_t MCP7941x<Transport>::stampBefore(const uint8_t* ts, const time_t limit)
+{
+    uint8_t m = bcd2dec(ts[0]);
+    uint8_t h = bcd2dec(ts[1] & ~_BV(HR1224));     // assumes 24hr clock
+    uint8_t d = bcd2dec(ts[2]);
+    uint8_t mon = bcd2dec(ts[3] & 0x1F);            // mask off the day, we don't need it
+    int16_t y = MCP7941xCivil::year(MCP7941xCivil::civilFromDays(limit / MCP7941xCivil::DAY_SECONDS));
+    for (uint8_t i=0; i<8; ++i, --y) {
+        int32_t days = MCP7941xCivil::daysFromCivil(y, mon, d);
+        if (days < 0 || MCP7941xCivil::day(MCP7941xCivil::civilFromDays(days)) != d) continue;  // e.g. 29 Feb
+        time_t t = days * MCP7941xCivil::DAY_SECONDS + h * 3600UL + m * 60U;
+        if (t <= limit) return t;
+    }
+    return 0;
+}
+
+// Enable or disable the square wave output.
+template <class Transport>
+void MCP7941x<Transport>::squareWave(const SQWAVE_FREQS_t freq)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_CONTROL);
+    uint8_t ctrlReg {readConfig(CONTROL)};
+    if (freq > 3) {
+        ctrlReg &= ~_BV(SQWEN);
+    }
+    else {
+        ctrlReg = (ctrlReg & 0xF8) | _BV(SQWEN) | freq;
+    }
+    writeRTC(CONTROL, &ctrlReg, 1);
+}
+
+// Set an alarm to the given time_t value. Sets the alarm registers only,
+// does not enable the alarm. See enableAlarm().
+template <class Transport>
+void MCP7941x<Transport>::setAlarm(const ALARM_NBR_t alarmNumber, const time_t alarmTime)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_ALARM);
+    // need to preserve bits in the day (of week) register
+    uint8_t day {readConfig(alarmRegister(alarmNumber, ALM0WKDAY))};
+    uint8_t regs[tmNbrFields];
+    MCP7941xCivil::timeToRegs(alarmTime, regs);     // sets 24 hour format (Bit 6 == 0)
+    regs[3] |= day & 0xF8;
+    writeRTC(alarmRegister(alarmNumber, ALM0SEC), regs, 6);     // no year register
+}
+
+// Set an alarm by specifying year, month, day, hour, minute, second.
+// While the RTC does not use year for alarms, it's important to use the
+// correct year to ensure the day of the week is calculated correctly. This
+// is important especially if a day of week alarm will be used.
+// Use a four-digit year, including century e.g. CCYY.
+template <class Transport>
+void MCP7941x<Transport>::setAlarm(const ALARM_NBR_t alarmNumber, const uint16_t y, const uint8_t mon,
+                  const uint8_t d, const uint8_t h, const uint8_t m, const uint8_t s)
+{
+    MCP79412_STATS_SCOPE(OP_ALARM);
+    setAlarm(alarmNumber, MCP7941xCivil::fromCivil(y, mon, d, h, m, s));
+}
+
+// Enable or disable an alarm, and set the trigger criteria,
+// e.g. match only seconds, only minutes, entire time and date, etc.
+template <class Transport>
+void MCP7941x<Transport>::enableAlarm(const ALARM_NBR_t alarmNumber, const ALARM_TYPES_t alarmType)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_ALARM);
+    if (alarmType < ALM_DISABLE) {
+        // alarm day register has config & flag bits
+        uint8_t day {readConfig(alarmRegister(alarmNumber, ALM0WKDAY))};
+        day = ( day & 0x87 ) | alarmType << 4;  // reset interrupt flag, OR in the config bits
+        writeRTC(alarmRegister(alarmNumber, ALM0WKDAY), &day, 1);
+    }
+    setAlarmEnable(alarmNumber, alarmType < ALM_DISABLE);
+}
+
+// Set or clear an alarm's enable bit in the control register, leaving
+// its match mode and flag as they are.
+// Returns the I2C status of the write (zero if successful).
+template <class Transport>
+uint8_t MCP7941x<Transport>::setAlarmEnable(const ALARM_NBR_t alarmNumber, const bool enable)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_ALARM);
+    uint8_t ctrl {readConfig(CONTROL)};     // control register has alarm enable bits
+    if (enable)
+        ctrl |= _BV(ALM0EN + alarmNumber);
+    else
+        ctrl &= ~(_BV(ALM0EN + alarmNumber));
+    return writeRTC(CONTROL, &ctrl, 1);
+}
+
+// The ALMPOL bit as it is to be kept when writing the given alarm's
+// ALMxWKDAY register. ALMPOL is in ALM0WKDAY only, so this is zero for
+// alarm 1. The second form takes the value read from ALMxWKDAY.
+template <class Transport>
+uint8_t MCP7941x<Transport>::alarmPolarityBit(const ALARM_NBR_t alarmNumber)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_ALARM);
+    return alarmNumber == ALARM_0 ? readConfig(ALM0WKDAY) & _BV(ALMPOL) : 0;
+}
+
+// Returns true or false depending on whether the given alarm has been
+// triggered, and resets the alarm "interrupt" flag. This is not a real
+// interrupt, just a bit that's set when an alarm is triggered.
+template <class Transport>
+bool MCP7941x<Transport>::alarm(const ALARM_NBR_t alarmNumber)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_ALARM);
+    uint8_t day;                // alarm day register has config & flag bits
+    readRTC( alarmRegister(alarmNumber, ALM0WKDAY), &day, 1);
+    if (day & _BV(ALMxIF)) {
+        day &= ~_BV(ALMxIF);    // turn off the alarm "interrupt" flag
+        writeRTC( alarmRegister(alarmNumber, ALM0WKDAY), &day, 1);
+        return true;
+    }
+    else
+        return false;
+}
+
+// Sets the logic level on the MFP when it's not being used as a
+// square wave or alarm output. The default is HIGH.
+template <class Transport>
+void MCP7941x<Transport>::out(const bool level)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_CONTROL);
+    uint8_t ctrlReg {readConfig(CONTROL)};
+    if (level)
+        ctrlReg |= _BV(OUT);
+    else
+        ctrlReg &= ~_BV(OUT);
+    writeRTC(CONTROL, &ctrlReg, 1);
+}
+
+// Specifies the logic level on the Multi-Function Pin (MFP) when an
+// alarm is triggered. The default is LOW. When both alarms are
+// active, the two are ORed together to determine the level of the MFP.
+// With alarm polarity set to LOW (the default), this causes the MFP
+// to go low only when BOTH alarms are triggered. With alarm polarity
+// set to HIGH, the MFP will go high when EITHER alarm is triggered.
+//
+// Note that the state of the MFP is independent of the alarm
+// "interrupt" flags, and the alarm() function will indicate when an
+// alarm is triggered regardless of the polarity.
+template <class Transport>
+void MCP7941x<Transport>::alarmPolarity(const bool polarity)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_ALARM);
+    uint8_t alm0Day {readConfig(ALM0WKDAY)};
+    if (polarity)
+        alm0Day |= _BV(ALMPOL);
+    else
+        alm0Day &= ~_BV(ALMPOL);
+    writeRTC(ALM0WKDAY, &alm0Day, 1);
+}
+
+// Check to see if the RTC's oscillator is started (STOSC bit in seconds
+// register). Returns true if started.
+template <class Transport>
+bool MCP7941x<Transport>::isRunning()
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_CONTROL);
+    bus.beginTransmission(RTC_ADDR);
+    bus.write(RTCSEC);
+    bus.endTransmission(false);
+
+    // request just the seconds register
+    bus.requestFrom(RTC_ADDR, static_cast<uint8_t>(1));
+    return bus.read() & _BV(STOSC);
+}
+
+// Set or clear the VBATEN bit. Setting the bit powers the clock and
+// SRAM from the backup battery when Vcc falls. Note that setting the
+// time via set() or write() sets the VBATEN bit.
+template <class Transport>
+void MCP7941x<Transport>::vbaten(const bool enable)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_CONTROL);
+    uint8_t day;
+    readRTC(RTCWKDAY, &day, 1);
+    if (enable)
+        day |= _BV(VBATEN);
+    else
+        day &= ~_BV(VBATEN);
+
+    writeRTC(RTCWKDAY, &day, 1);
+    return;
+}
+
+// Set the largest I2C transfer, in bytes, including the register address
+// byte for writes. Longer reads and writes are split into transfers of
+// this size. The default (I2C_BUFFER_SIZE) is the buffer size of the
+// I2C library, if known, else 32. A larger value can be given if the
+// I2C library is known to buffer more. Values less than 2 are ignored.
+template <class Transport>
+void MCP7941x<Transport>::setI2CBufferSize(const uint8_t size)
+{
+    if (size >= 2) i2cBufSize = size;
+}
+
+// Enable or disable the register shadow. When enabled, the library
+// keeps write-through copies of the CONTROL, ALM0WKDAY and ALM1WKDAY
+// registers, so that squareWave(), out(), setAlarm(), enableAlarm()
+// and alarmPolarity() cost a single write instead of a read-modify-write.
+// The shadow is loaded by begin(), or by the first function that needs
+// it, and is kept up to date by writeRTC() and readRTC(), so direct
+// register access through those functions is safe. If something else
+// changes these registers (e.g. the RTC loses power with no backup
+// battery), call shadowRegisters(true) again to reload it.
+//
+// The ALMxIF flags are set by hardware and so are not shadowed. The
+// configuration functions write them as ones, which leaves them as they
+// are, since software can clear the flags but not set them. RTCWKDAY is
+// not shadowed because the RTC advances its weekday field and owns its
+// OSCRUN and PWRFAIL bits, which is why vbaten() still reads it.
+template <class Transport>
+void MCP7941x<Transport>::shadowRegisters(const bool enable)
+{
+    MCP79412BusGuard guard(busLock);
+    MCP79412_STATS_SCOPE(OP_CONTROL);
+    shadowOn = enable;
+    shadowValid = false;
+}
+
+// Return a pointer to the shadow copy of the given register,
+// or nullptr if the register is not shadowed.
+template <class Transport>
+uint8_t* MCP7941x<Transport>::shadowReg(const uint8_t addr)
+{
+    switch (addr) {
+        case CONTROL:   return &shadowCtrl;
+        case ALM0WKDAY: return &shadowAlmDay[0];
+        case ALM1WKDAY: return &shadowAlmDay[1];
+        default:        return nullptr;
+    }
+}
+
+// Load the shadow registers from the RTC with a single burst read.
+// Returns true if successful.
+template <class Transport>
+bool MCP7941x<Transport>::shadowLoad()
+{
+    uint8_t regs[ALM1WKDAY - CONTROL + 1];
+    shadowValid = true;     // allow readRTC() to fill the shadow
+    if (readRTC(CONTROL, regs, sizeof(regs)) != 0) shadowValid = false;
+    return shadowValid;
+}
+
+// Update the shadow registers (if loaded) from values written to or
+// read from the RTC.
+template <class Transport>
+void MCP7941x<Transport>::shadowUpdate(const uint8_t addr, const uint8_t* values, const uint8_t nBytes)
+{
+    if (!shadowValid) return;
+    for (uint8_t i=0; i<nBytes; ++i) {
+        uint8_t* r = shadowReg(addr + i);
+        if (r) *r = (addr + i == CONTROL) ? values[i] : values[i] & ~_BV(ALMxIF);
+    }
+}
+
+// Get the value of CONTROL, ALM0WKDAY or ALM1WKDAY for a
+// read-modify-write, from the shadow if enabled, else from the RTC.
+template <class Transport>
+uint8_t MCP7941x<Transport>::readConfig(const uint8_t addr)
+{
+    MCP79412BusGuard guard(busLock);
+    if (shadowOn && (shadowValid || shadowLoad())) {
+        uint8_t value = *shadowReg(addr);
+        return (addr == CONTROL) ? value : value | _BV(ALMxIF);
+    }
+    return readRTC(addr);
+}
+
+// dump rtc registers, 16 bytes at a time.
+// always dumps a multiple of 16 bytes.
+// duplicate rows are suppressed and indicated with an asterisk.
+template <class Transport>
+void MCP7941x<Transport>::dumpRegs(const uint32_t startAddr, const uint32_t nBytes)
+{
+    Serial.print(F("\nRTC REGISTERS\n"));
+    uint32_t nRows = (nBytes + 15) >> 4;
+
+    uint8_t d[16], last[16];
+    uint32_t aLast {startAddr};
+    for (uint32_t r = 0; r < nRows; r++) {
+        uint32_t a = startAddr + 16 * r;
+        readRTC(a, d, 16);
+        bool same {true};
+        for (int i=0; i<16; ++i) {
+            if (last[i] != d[i]) same = false;
+        }
+        if (!same || r == 0 || r == nRows-1) {
+            Serial.print(F("0x"));
+            if ( a < 16 * 16 * 16 ) Serial.print('0');
+            if ( a < 16 * 16 ) Serial.print('0');
+            if ( a < 16 ) Serial.print('0');
+            Serial.print(a, HEX);
+            Serial.print(a == aLast+16 || r == 0 ? "  " : "* ");
+            for ( int16_t c = 0; c < 16; c++ ) {
+                if ( d[c] < 16 ) Serial.print('0');
+                Serial.print(d[c], HEX);
+                Serial.print(c == 7 ? "  " : " " );
+            }
+            Serial.println();
+            aLast = a;
+        }
+        for (int i=0; i<16; ++i) {
+            last[i] = d[i];
+        }
+    }
+}
+
+// dump rtc sram, 16 bytes at a time.
+// always dumps a multiple of 16 bytes.
+// duplicate rows are suppressed and indicated with an asterisk.
+template <class Transport>
+void MCP7941x<Transport>::dumpSRAM(const uint32_t startAddr, const uint32_t nBytes)
+{
+    Serial.print(F("\nRTC SRAM\n"));
+    uint32_t nRows = (nBytes + 15) >> 4;
+
+    uint8_t d[16], last[16];
+    uint32_t aLast {startAddr};
+    for (uint32_t r = 0; r < nRows; r++) {
+        uint32_t a = startAddr + 16 * r;
+        sramRead(a, d, 16);
+        bool same {true};
+        for (int i=0; i<16; ++i) {
+            if (last[i] != d[i]) same = false;
+        }
+        if (!same || r == 0 || r == nRows-1) {
+            Serial.print(F("0x"));
+            if ( a < 16 * 16 * 16 ) Serial.print('0');
+            if ( a < 16 * 16 ) Serial.print('0');
+            if ( a < 16 ) Serial.print('0');
+            Serial.print(a, HEX);
+            Serial.print(a == aLast+16 || r == 0 ? "  " : "* ");
+            for ( int16_t c = 0; c < 16; c++ ) {
+                if ( d[c] < 16 ) Serial.print('0');
+                Serial.print(d[c], HEX);
+                Serial.print(c == 7 ? "  " : " " );
+            }
+            Serial.println();
+            aLast = a;
+        }
+        for (int i=0; i<16; ++i) {
+            last[i] = d[i];
+        }
+    }
+}
+
+// dump rtc eeprom, 16 bytes at a time.
+// always dumps a multiple of 16 bytes.
+// duplicate rows are suppressed and indicated with an asterisk.
+template <class Transport>
+void MCP7941x<Transport>::dumpEEPROM(const uint32_t startAddr, const uint32_t nBytes)
+{
+    Serial.print(F("\nRTC EEPROM\n"));
+    uint32_t nRows = (nBytes + 15) >> 4;
+
+    uint8_t d[16], last[16];
+    uint32_t aLast {startAddr};
+    for (uint32_t r = 0; r < nRows; r++) {
+        uint32_t a = startAddr + 16 * r;
+        eepromRead(a, d, 16);
+        bool same {true};
+        for (int i=0; i<16; ++i) {
+            if (last[i] != d[i]) same = false;
+        }
+        if (!same || r == 0 || r == nRows-1) {
+            Serial.print(F("0x"));
+            if ( a < 16 * 16 * 16 ) Serial.print('0');
+            if ( a < 16 * 16 ) Serial.print('0');
+            if ( a < 16 ) Serial.print('0');
+            Serial.print(a, HEX);
+            Serial.print(a == aLast+16 || r == 0 ? "  " : "* ");
+            for ( int16_t c = 0; c < 16; c++ ) {
+                if ( d[c] < 16 ) Serial.print('0');
+                Serial.print(d[c], HEX);
+                Serial.print(c == 7 ? "  " : " " );
+            }
+            Serial.println();
+            aLast = a;
+        }
+        for (int i=0; i<16; ++i) {
+            last[i] = d[i];
+        }
+    }
+}
+#endif
@@ -0,0 +1,76 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Loop-free time conversions, see MCP7941xCivil.h.
+
+#include <MCP7941xCivil.h>
+
+const uint8_t MCP7941xCivil::DEC2BCD[100] PROGMEM {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59,
+    0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79,
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99
+};
+
+// the value of the tens digit of a BCD number, by its upper nibble
+const uint8_t MCP7941xCivil::BCD_TENS[16] PROGMEM {
+    0, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120, 130, 140, 150
+};
+
+// Convert the seven time and date registers to a time_t. The control
+// and status bits (STOSC, HR1224, OSCRUN, PWRFAIL, VBATEN, LPYR) are
+// masked off; the hour is assumed to be in 24 hour format.
+time_t MCP7941xCivil::regsToTime(const uint8_t* regs)
+{
+    int32_t days = daysFromCivil(2000 + bcd2dec(regs[6]), bcd2dec(regs[5] & 0x1F), bcd2dec(regs[4] & 0x3F));
+    return days * DAY_SECONDS + bcd2dec(regs[2] & 0x3F) * 3600UL
+        + bcd2dec(regs[1] & 0x7F) * 60U + bcd2dec(regs[0] & 0x7F);
+}
+
+// Convert a time_t to the seven time and date registers, see the header.
+void MCP7941xCivil::timeToRegs(const time_t t, uint8_t* regs)
+{
+    uint32_t days = static_cast<uint32_t>(t) / DAY_SECONDS;
+    uint32_t secs = static_cast<uint32_t>(t) - days * DAY_SECONDS;
+    uint8_t h = secs / 3600;
+    uint16_t rem = secs - h * 3600UL;
+    uint8_t m = rem / 60;
+    uint32_t civil = civilFromDays(days);
+    regs[0] = dec2bcd(rem - m * 60);
+    regs[1] = dec2bcd(m);
+    regs[2] = dec2bcd(h);
+    regs[3] = weekdayFromDays(days);
+    regs[4] = dec2bcd(day(civil));
+    regs[5] = dec2bcd(month(civil));
+    regs[6] = dec2bcd(year(civil) - 2000);
+}
+
+// As the Time library's makeTime().
+time_t MCP7941xCivil::makeTime(const tmElements_t& tm)
+{
+    return fromCivil(tmYearToCalendar(tm.Year), tm.Month, tm.Day, tm.Hour, tm.Minute, tm.Second);
+}
+
+// As the Time library's breakTime().
+void MCP7941xCivil::breakTime(const time_t t, tmElements_t& tm)
+{
+    uint32_t days = static_cast<uint32_t>(t) / DAY_SECONDS;
+    uint32_t secs = static_cast<uint32_t>(t) - days * DAY_SECONDS;
+    tm.Hour = secs / 3600;
+    uint16_t rem = secs - tm.Hour * 3600UL;
+    tm.Minute = rem / 60;
+    tm.Second = rem - tm.Minute * 60;
+    tm.Wday = weekdayFromDays(days);
+    uint32_t civil = civilFromDays(days);
+    tm.Day = day(civil);
+    tm.Month = month(civil);
+    tm.Year = CalendarYrToTm(year(civil));
+}
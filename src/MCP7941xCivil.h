@@ -0,0 +1,108 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// Conversions between time_t, the calendar and the RTC's registers,
+// without loops. The Time library's makeTime() and breakTime() loop
+// over the years since 1970 and the months of the year, which takes
+// thousands of cycles on AVR. These use the days-from-civil and
+// civil-from-days algorithms of Howard Hinnant
+// (https://howardhinnant.github.io/date_algorithms.html), which take a
+// fixed handful of multiplications and divisions by constants. The
+// calendar functions are constexpr, so they can also be used at
+// compile time, e.g. for a time_t constant. They are valid for times
+// from 1970 through 2105, the range of an unsigned 32-bit time_t.
+//
+// BCD conversion is by table lookup (the tables are in flash on AVR),
+// avoiding a division by 10.
+
+#ifndef MCP7941X_CIVIL_H_INCLUDED
+#define MCP7941X_CIVIL_H_INCLUDED
+
+#include <Arduino.h>
+#include <TimeLib.h>    // https://github.com/PaulStoffregen/Time
+
+class MCP7941xCivil
+{
+    public:
+        // Days from 1970-01-01 to the given date. y is the calendar
+        // year (e.g. 2025), m is 1-12, d is 1-31.
+        static constexpr int32_t daysFromCivil(const int16_t y, const uint8_t m, const uint8_t d)
+        {
+            return daysFromShifted(y - (m <= 2), m > 2 ? m - 3 : m + 9, d);
+        }
+
+        // The date that is the given number of days after 1970-01-01,
+        // packed as year << 16 | month << 8 | day, see year(), month()
+        // and day().
+        static constexpr uint32_t civilFromDays(const int32_t z)
+        {
+            return fromDoe((z + 719468) / 146097, (z + 719468) % 146097);
+        }
+        static constexpr int16_t year(const uint32_t civil) {return civil >> 16;}
+        static constexpr uint8_t month(const uint32_t civil) {return civil >> 8;}
+        static constexpr uint8_t day(const uint32_t civil) {return civil;}
+
+        // Day of the week, as in the Time library: Sunday is 1.
+        static constexpr uint8_t weekdayFromDays(const int32_t z) {return (z + 4) % 7 + 1;}
+
+        static constexpr uint32_t DAY_SECONDS {86400};
+
+        // The time_t for a calendar date and time.
+        static constexpr uint32_t fromCivil(const int16_t y, const uint8_t mon, const uint8_t d,
+                                            const uint8_t h, const uint8_t m, const uint8_t s)
+        {
+            return daysFromCivil(y, mon, d) * DAY_SECONDS + h * 3600UL + m * 60U + s;
+        }
+
+        static uint8_t dec2bcd(const uint8_t n) {return n < 100 ? pgm_read_byte(&DEC2BCD[n]) : 0;}
+        static uint8_t bcd2dec(const uint8_t n) {return pgm_read_byte(&BCD_TENS[n >> 4]) + (n & 0x0F);}
+
+        // time_t from the seven time and date registers, RTCSEC through
+        // RTCYEAR (the control bits are ignored), and the reverse.
+        // timeToRegs() sets the seconds (with STOSC clear), minute, hour
+        // (24 hour format), day of the week (without the status bits),
+        // date, month and year registers.
+        static time_t regsToTime(const uint8_t* regs);
+        static void timeToRegs(const time_t t, uint8_t* regs);
+
+        // Replacements for the Time library's makeTime() and breakTime().
+        static time_t makeTime(const tmElements_t& tm);
+        static void breakTime(const time_t t, tmElements_t& tm);
+
+    private:
+        static const uint8_t DEC2BCD[100];
+        static const uint8_t BCD_TENS[16];
+
+        // days from 0000-03-01, with the year starting in March (mp = 0)
+        // so that the leap day is the last day of the year
+        static constexpr int32_t daysFromShifted(const int32_t y, const uint8_t mp, const uint8_t d)
+        {
+            return 365 * y + y / 4 - y / 100 + y / 400 + (153 * mp + 2) / 5 + d - 1 - 719468;
+        }
+        // doe: day of the 400-year era, yoe: year of the era,
+        // doy: day of the (shifted) year
+        static constexpr uint32_t fromDoe(const uint32_t era, const uint32_t doe)
+        {
+            return fromYoe(era, doe, (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365);
+        }
+        static constexpr uint32_t fromYoe(const uint32_t era, const uint32_t doe, const uint32_t yoe)
+        {
+            return fromDoy(era * 400 + yoe, doe - (365 * yoe + yoe / 4 - yoe / 100));
+        }
+        static constexpr uint32_t fromDoy(const uint32_t y, const uint32_t doy)
+        {
+            return fromMp(y, doy, (5 * doy + 2) / 153);
+        }
+        static constexpr uint32_t fromMp(const uint32_t y, const uint32_t doy, const uint32_t mp)
+        {
+            return (y + (mp >= 10)) << 16 | (mp < 10 ? mp + 3 : mp - 9) << 8 | (doy - (153 * mp + 2) / 5 + 1);
+        }
+};
+
+static_assert(MCP7941xCivil::daysFromCivil(1970, 1, 1) == 0, "days from civil");
+static_assert(MCP7941xCivil::daysFromCivil(2000, 3, 1) == 11017, "days from civil");
+static_assert(MCP7941xCivil::civilFromDays(11016) == (2000UL << 16 | 2 << 8 | 29), "civil from days");
+static_assert(MCP7941xCivil::fromCivil(2025, 1, 1, 0, 0, 0) == 1735689600UL, "civil to time_t");
+#endif
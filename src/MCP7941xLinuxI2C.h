@@ -0,0 +1,178 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// I2C transport for Linux (e.g. a Raspberry Pi or other single-board
+// computer), using the i2c-dev interface, /dev/i2c-N. For use with the
+// MCP7941x<Transport> template, see MCP7941x.h:
+//     MCP7941x<LinuxI2CTransport> myRTC {LinuxI2CTransport{"/dev/i2c-1"}};
+//
+// Each transfer is one I2C_RDWR ioctl() call. Writes are buffered until
+// endTransmission(). endTransmission(false), which the library uses
+// to send a register address before a read, sends nothing: the address
+// write goes with the following requestFrom() as a single I2C_RDWR call
+// of two messages, which the adapter sends with a repeated START. So a
+// burst read of registers, SRAM or EEPROM is one system call, and so is
+// a write of registers, SRAM or an EEPROM page.
+//
+// The ioctl() function is called through a pointer, so that a program
+// can run the library against a fake i2c-dev device, see
+// extras/host/HostI2CDev.h. (The kernel's i2c-stub module emulates
+// only SMBus transfers, not I2C_RDWR.)
+//
+// The rest of the library needs the Arduino API (millis(), delay(),
+// Serial) and the Time library. This library's only stand-ins for them
+// are those in extras/host; for a real device, build them with
+// HOST_REAL_TIME defined, so that millis(), micros() and delay() use
+// the real time (see extras/host/README.md), or supply your own.
+//
+// Status codes are those of the Wire library: 1 = data too long for the
+// buffer, 2 = not acknowledged (i2c-dev does not tell an address NACK
+// from a data NACK), 4 = other error, 5 = timeout.
+
+#ifndef MCP7941X_LINUX_I2C_H_INCLUDED
+#define MCP7941X_LINUX_I2C_H_INCLUDED
+#ifdef __linux__
+
+#include <Arduino.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+class LinuxI2CTransport
+{
+    public:
+        typedef int (*IOCTL_t)(int fd, unsigned long request, void* arg);
+        static constexpr uint8_t BUFFER_SIZE {255};
+        // each poll of a busy EEPROM is a system call and ties up the
+        // adapter, so sleep through most of the write cycle (5ms max)
+        static constexpr uint16_t
+            EEPROM_WAIT_MICROS {4000},
+            EEPROM_POLL_MICROS {500};
+
+        // the device is opened by begin()
+        LinuxI2CTransport(const char* device="/dev/i2c-1")
+            : m_device{device}, m_fd{-1}, m_ioctl{sysIoctl} {}
+        // use a device that is already open, and optionally another ioctl()
+        LinuxI2CTransport(const int fd, IOCTL_t ioctlFn=sysIoctl)
+            : m_device{nullptr}, m_fd{fd}, m_ioctl{ioctlFn} {}
+
+        void begin() {if (m_fd < 0 && m_device) m_fd = ::open(m_device, O_RDWR);}
+        void end();
+        void beginTransmission(const uint8_t addr);
+        void write(const uint8_t b);
+        uint8_t endTransmission(const bool sendStop=true);
+        uint8_t requestFrom(const uint8_t addr, const uint8_t n);
+        uint8_t read() {return m_rxIdx < m_rxLen ? m_rx[m_rxIdx++] : 0xFF;}
+
+        int fd() {return m_fd;}
+        int lastErrno() {return m_errno;}       // errno from the last failed call
+        uint32_t syscalls() {return m_syscalls;}    // ioctl() calls made
+
+        static int sysIoctl(int fd, unsigned long request, void* arg) {return ::ioctl(fd, request, arg);}
+
+    private:
+        const char* m_device;       // device to open, nullptr if given an fd
+        int m_fd;
+        IOCTL_t m_ioctl;
+        int m_errno {0};
+        uint32_t m_syscalls {0};
+        uint8_t m_addr {0};         // address of the buffered write
+        bool m_overflow {false};    // more bytes written than fit in the buffer
+        bool m_pending {false};     // a write is waiting to go with the next read
+        uint8_t m_txLen {0};
+        uint8_t m_rxLen {0};
+        uint8_t m_rxIdx {0};
+        uint8_t m_tx[BUFFER_SIZE];
+        uint8_t m_rx[BUFFER_SIZE];
+        uint8_t transfer(i2c_msg* msgs, const uint8_t nMsgs);
+        uint8_t flush();
+};
+
+// Close the device, if it was opened by begin().
+inline void LinuxI2CTransport::end()
+{
+    if (m_device && m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+// Start buffering a write to the given address. A write left pending
+// by endTransmission(false) and not followed by a read is sent first.
+inline void LinuxI2CTransport::beginTransmission(const uint8_t addr)
+{
+    if (m_pending) flush();
+    m_addr = addr;
+    m_txLen = 0;
+    m_overflow = false;
+}
+
+inline void LinuxI2CTransport::write(const uint8_t b)
+{
+    if (m_txLen < BUFFER_SIZE) m_tx[m_txLen++] = b;
+    else m_overflow = true;
+}
+
+// Send the buffered write, or, if sendStop is false, keep it to send
+// with the next requestFrom().
+inline uint8_t LinuxI2CTransport::endTransmission(const bool sendStop)
+{
+    if (m_overflow) return 1;
+    m_pending = true;
+    return sendStop ? flush() : 0;
+}
+
+// Read n bytes from the given address into the receive buffer. If a
+// write to the same address is pending, it is sent first, with a
+// repeated START, in the same ioctl() call. Returns the number of bytes
+// read, zero on error.
+inline uint8_t LinuxI2CTransport::requestFrom(const uint8_t addr, const uint8_t n)
+{
+    m_rxLen = m_rxIdx = 0;
+    if (m_pending && m_addr != addr && flush() != 0) return 0;
+    i2c_msg msgs[2];
+    uint8_t nMsgs {0};
+    if (m_pending) {
+        msgs[nMsgs++] = {m_addr, 0, m_txLen, m_tx};
+        m_pending = false;
+    }
+    msgs[nMsgs++] = {addr, I2C_M_RD, n, m_rx};
+    if (transfer(msgs, nMsgs) != 0) return 0;
+    m_rxLen = n;
+    return n;
+}
+
+// Send the pending write on its own.
+inline uint8_t LinuxI2CTransport::flush()
+{
+    i2c_msg msg {m_addr, 0, m_txLen, m_tx};
+    m_pending = false;
+    return transfer(&msg, 1);
+}
+
+// One I2C_RDWR call, returns a Wire library status.
+inline uint8_t LinuxI2CTransport::transfer(i2c_msg* msgs, const uint8_t nMsgs)
+{
+    i2c_rdwr_ioctl_data data {msgs, nMsgs};
+    ++m_syscalls;
+    if (m_ioctl(m_fd, I2C_RDWR, &data) >= 0) return 0;
+    m_errno = errno;
+    switch (m_errno) {
+        case ENXIO:
+        case EREMOTEIO:
+        case EIO:
+            return 2;
+        case ETIMEDOUT:
+            return 5;
+        default:
+            return 4;
+    }
+}
+
+#endif
+#endif
@@ -0,0 +1,115 @@
+// Arduino MCP79412RTC Library
+// https://github.com/JChristensen/MCP79412RTC
+// Copyright (C) 2025 by Jack Christensen and licensed under
+// GNU GPL v3.0, https://www.gnu.org/licenses/gpl.html
+//
+// I2C transports for the MCP7941x<Transport> template (see MCP7941x.h).
+// A transport is any class with these members, with the semantics of
+// the Arduino Wire library:
+//     void begin();
+//     void beginTransmission(uint8_t addr);
+//     void write(uint8_t b);
+//     uint8_t endTransmission(bool sendStop=true);    // false: the next START is a repeated START
+//     uint8_t requestFrom(uint8_t addr, uint8_t n);
+//     uint8_t read();
+//     static constexpr uint8_t BUFFER_SIZE;          // largest transfer, including the register address byte
+// and optionally
+//     static constexpr uint16_t EEPROM_WAIT_MICROS;  // wait after starting an EEPROM write cycle, before polling
+//     static constexpr uint16_t EEPROM_POLL_MICROS;  // and between polls
+// Without them (see MCP7941xEepromWait and MCP7941xEepromPoll below), the EEPROM is polled back to
+// back, which on a microcontroller costs only a few bus cycles a poll.
+// A transport whose transfers are expensive, e.g. a system call each,
+// sets them to sleep through most of the write cycle instead.
+// endTransmission() returns the Wire library's status codes (0 success,
+// 1 data too long, 2 address NACK, 3 data NACK, 4 other error), so the
+// library can tell a busy EEPROM (address NACK, MCP7941xBase::
+// I2C_NACK_ADDR) from an error whatever the I2C library underneath.
+// The transport's functions are called directly, not through virtual
+// functions, so a transport whose functions are inline costs nothing.
+//
+// WireTransport uses a TwoWire object (Wire, Wire1, ..., or the host
+// simulator's Wire, see extras/host), TinyWireMTransport the TinyWireM
+// library on ATtiny, translating its USI status codes to Wire's.
+
+#ifndef MCP7941X_TRANSPORT_H_INCLUDED
+#define MCP7941X_TRANSPORT_H_INCLUDED
+
+#include <Arduino.h>
+
+#if defined(__AVR_ATtiny44__) || defined(__AVR_ATtiny84__) || defined(__AVR_ATtiny45__) || defined(__AVR_ATtiny85__)
+#define MCP79412_TINYWIREM
+#include <TinyWireM.h>
+#endif
+#include <Wire.h>
+
+#ifndef BUFFER_LENGTH       // a horrible and limiting kludge for samd (arduino zero)
+#define BUFFER_LENGTH 32
+#endif
+
+// largest I2C transfer (bytes, including a register address byte) that
+// the I2C library can buffer. can be overridden with a build flag, or at
+// run time with setI2CBufferSize().
+#ifndef MCP79412_I2C_BUFFER
+#if defined(MCP79412_TINYWIREM)
+#define MCP79412_I2C_BUFFER (USI_BUF_SIZE - 1)  // TinyWireM also buffers the device address
+#elif defined(I2C_BUFFER_LENGTH)                // e.g. esp32
+#define MCP79412_I2C_BUFFER I2C_BUFFER_LENGTH
+#else
+#define MCP79412_I2C_BUFFER BUFFER_LENGTH
+#endif
+#endif
+
+class WireTransport
+{
+    public:
+        static constexpr uint8_t BUFFER_SIZE {MCP79412_I2C_BUFFER > 255 ? 255 : MCP79412_I2C_BUFFER};
+
+        WireTransport(TwoWire& tw=Wire) : m_wire(tw) {}
+        void begin() {m_wire.begin();}
+        void beginTransmission(const uint8_t addr) {m_wire.beginTransmission(addr);}
+        void write(const uint8_t b) {m_wire.write(b);}
+        uint8_t endTransmission(const bool sendStop=true) {return m_wire.endTransmission(sendStop);}
+        uint8_t requestFrom(const uint8_t addr, const uint8_t n) {return m_wire.requestFrom(addr, n);}
+        uint8_t read() {return m_wire.read();}
+        TwoWire& wire() {return m_wire;}
+
+    private:
+        TwoWire& m_wire;
+};
+
+// The EEPROM pacing of a transport, zero if it does not give it.
+template <class T, class = void>
+struct MCP7941xEepromWait {static constexpr uint16_t value {0};};
+template <class T>
+struct MCP7941xEepromWait<T, decltype(void(T::EEPROM_WAIT_MICROS))> {static constexpr uint16_t value {T::EEPROM_WAIT_MICROS};};
+template <class T, class = void>
+struct MCP7941xEepromPoll {static constexpr uint16_t value {0};};
+template <class T>
+struct MCP7941xEepromPoll<T, decltype(void(T::EEPROM_POLL_MICROS))> {static constexpr uint16_t value {T::EEPROM_POLL_MICROS};};
+
+#ifdef MCP79412_TINYWIREM
+class TinyWireMTransport
+{
+    public:
+        static constexpr uint8_t BUFFER_SIZE {MCP79412_I2C_BUFFER};
+
+        void begin() {TinyWireM.begin();}
+        void beginTransmission(const uint8_t addr) {TinyWireM.beginTransmission(addr);}
+        void write(const uint8_t b) {TinyWireM.send(b);}
+        uint8_t endTransmission(const bool) {return wireStatus(TinyWireM.endTransmission());}   // always sends STOP
+        uint8_t endTransmission() {return wireStatus(TinyWireM.endTransmission());}
+        uint8_t requestFrom(const uint8_t addr, const uint8_t n) {return TinyWireM.requestFrom(addr, n);}
+        uint8_t read() {return TinyWireM.receive();}
+
+    private:
+        // USI_TWI_NO_ACK_ON_ADDRESS (1) and USI_TWI_NO_ACK_ON_DATA (2)
+        // are Wire's 2 and 3, USI_TWI_DATA_OUT_OF_BOUND (9) is Wire's 1,
+        // and the rest are "other error".
+        static uint8_t wireStatus(const uint8_t e)
+            {return e == 0 ? 0 : e == 1 ? 2 : e == 2 ? 3 : e == 9 ? 1 : 4;}
+};
+using MCP7941xDefaultTransport = TinyWireMTransport;
+#else
+using MCP7941xDefaultTransport = WireTransport;
+#endif
+#endif